@@ -0,0 +1,411 @@
+//
+// Benchmarks: JSON
+//
+// Description: Throughput (MB/s) and heap allocations per document of
+// the main JSON parse/stringify paths (parseBuffer, parseFile,
+// stringifyToBuffer, stripWhiteSpaceBuffer and the default translator)
+// over generated corpora that each stress a different part of the code:
+// wide objects, deep nesting, numeric arrays, string heavy and unicode
+// heavy documents. Corpora are generated from a fixed seed so figures are
+// comparable from one release to the next; the results may be written as
+// CSV for tracking. Allocations are counted by replacing the global
+// operator new. Build with -DCMAKE_BUILD_TYPE=Release for real figures.
+//
+// Usage: JSON_Benchmarks [--size MB] [--min-time seconds] [--csv]
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSON.hpp"
+#include "JSONTranslator.hpp"
+// ============
+// STL includes
+// ============
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+// =======================
+// JSON class namespace
+// =======================
+using namespace H4;
+// =======================
+// Allocation counting
+// =======================
+static std::atomic<std::size_t> allocationCount{0};
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc((size != 0) ? size : 1))
+    {
+        return (memory);
+    }
+    throw std::bad_alloc();
+}
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void *memory = std::aligned_alloc(align, ((size + align - 1) / align) * align))
+    {
+        return (memory);
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+// ===========================
+// Benchmark types and options
+// ===========================
+//
+// Generated document and what it is called in the results.
+//
+struct Corpus
+{
+    std::string name;
+    std::string json;
+};
+//
+// Benchmark settings.
+//
+struct Options
+{
+    std::size_t corpusSize = 8 * 1024 * 1024;
+    double minimumTime = 0.5;
+    bool csv = false;
+};
+// ==========================
+// Corpus generation
+// ==========================
+/// <summary>
+/// Array of objects with many keys each of mixed scalar values.
+/// </summary>
+/// <param name="size">Approximate size of corpus in bytes.</param>
+/// <param name="random">Random number generator.</param>
+/// <returns>Corpus JSON.</returns>
+static std::string generateWideObjects(std::size_t size, std::mt19937 &random)
+{
+    std::string json{"["};
+    while (json.size() < size)
+    {
+        json += "\n  {";
+        for (int field = 0; field < 200; field++)
+        {
+            char key[32];
+            std::snprintf(key, sizeof(key), "\"field%04d\": ", field);
+            json += (field > 0) ? ", " : "";
+            json += key;
+            switch (random() % 4)
+            {
+            case 0:
+                json += std::to_string(random() % 1000000);
+                break;
+            case 1:
+                json += "\"value" + std::to_string(random() % 1000) + "\"";
+                break;
+            case 2:
+                json += (random() & 1) ? "true" : "false";
+                break;
+            default:
+                json += "null";
+            }
+        }
+        json += "},";
+    }
+    json.back() = ']';
+    return (json);
+}
+/// <summary>
+/// Array of documents each nested several hundred objects/arrays deep.
+/// </summary>
+/// <param name="size">Approximate size of corpus in bytes.</param>
+/// <param name="random">Random number generator.</param>
+/// <returns>Corpus JSON.</returns>
+static std::string generateDeepNesting(std::size_t size, std::mt19937 &random)
+{
+    const int depth = 500;
+    std::string json{"["};
+    while (json.size() < size)
+    {
+        json += "\n  ";
+        for (int level = 0; level < depth; level++)
+        {
+            json += (level & 1) ? "{\"level\": " : "[";
+        }
+        json += std::to_string(random() % 100);
+        for (int level = depth; level-- > 0;)
+        {
+            json += (level & 1) ? "}" : "]";
+        }
+        json += ",";
+    }
+    json.back() = ']';
+    return (json);
+}
+/// <summary>
+/// Array of arrays of integers and floating point numbers.
+/// </summary>
+/// <param name="size">Approximate size of corpus in bytes.</param>
+/// <param name="random">Random number generator.</param>
+/// <returns>Corpus JSON.</returns>
+static std::string generateNumericArrays(std::size_t size, std::mt19937 &random)
+{
+    std::uniform_real_distribution<double> real(-1.0e6, 1.0e6);
+    std::string json{"["};
+    while (json.size() < size)
+    {
+        json += "\n  [";
+        for (int element = 0; element < 1000; element++)
+        {
+            json += (element > 0) ? ", " : "";
+            switch (random() % 3)
+            {
+            case 0:
+                json += std::to_string((long long)random() - (long long)(std::mt19937::max() / 2));
+                break;
+            case 1:
+            {
+                char buffer[JNumeric::kMaxTextLength];
+                JNumeric numeric;
+                numeric.kind = JNumeric::Kind::floatingPoint;
+                numeric.floatingPoint = real(random);
+                json.append(buffer, numeric.toChars(buffer));
+                break;
+            }
+            default:
+                json += std::to_string(random() % 1000) + "." + std::to_string(random() % 1000) + "e" + std::to_string((int)(random() % 40) - 20);
+            }
+        }
+        json += "],";
+    }
+    json.back() = ']';
+    return (json);
+}
+/// <summary>
+/// Array of records with long ASCII strings containing some escapes.
+/// </summary>
+/// <param name="size">Approximate size of corpus in bytes.</param>
+/// <param name="random">Random number generator.</param>
+/// <returns>Corpus JSON.</returns>
+static std::string generateStringHeavy(std::size_t size, std::mt19937 &random)
+{
+    static const char *words[] = {"lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit",
+                                  "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et", "dolore"};
+    static const char *escapes[] = {"\\\"", "\\\\", "\\n", "\\t", "\\/"};
+    std::string json{"["};
+    for (int record = 0; json.size() < size; record++)
+    {
+        json += "\n  {\"id\": " + std::to_string(record) + ", \"title\": \"Record " + std::to_string(record) + "\", \"text\": \"";
+        for (int word = 0; word < 200; word++)
+        {
+            json += words[random() % (sizeof(words) / sizeof(words[0]))];
+            json += ((random() % 20) == 0) ? escapes[random() % (sizeof(escapes) / sizeof(escapes[0]))] : " ";
+        }
+        json += "\"},";
+    }
+    json.back() = ']';
+    return (json);
+}
+/// <summary>
+/// Array of strings of non-ASCII text, both raw UTF-8 and "\uxxxx"
+/// escapes (including surrogate pairs).
+/// </summary>
+/// <param name="size">Approximate size of corpus in bytes.</param>
+/// <param name="random">Random number generator.</param>
+/// <returns>Corpus JSON.</returns>
+static std::string generateUnicodeHeavy(std::size_t size, std::mt19937 &random)
+{
+    static const char *characters[] = {"é", "ü", "€", "日本語", "Ж", "\U0001F600",
+                                       "\\u00e9", "\\u20AC", "\\u65E5", "\\uD83D\\uDE00", "\\uD834\\uDD1E", "a", "b", " "};
+    std::string json{"["};
+    while (json.size() < size)
+    {
+        json += "\n  \"";
+        for (int character = 0; character < 100; character++)
+        {
+            json += characters[random() % (sizeof(characters) / sizeof(characters[0]))];
+        }
+        json += "\",";
+    }
+    json.back() = ']';
+    return (json);
+}
+// ==========================
+// Benchmark helper functions
+// ==========================
+/// <summary>
+/// Run an operation repeatedly for at least the minimum time and report
+/// its throughput and the heap allocations it made per run. The reset
+/// function is run (untimed) between runs to free any result.
+/// </summary>
+/// <param name="options">Benchmark settings.</param>
+/// <param name="corpus">Corpus name.</param>
+/// <param name="operation">Operation name.</param>
+/// <param name="bytes">Bytes processed per run.</param>
+/// <param name="run">Operation to time.</param>
+/// <param name="reset">Clean up after each run.</param>
+/// <returns></returns>
+static void measure(const Options &options, const std::string &corpus, const std::string &operation, std::size_t bytes,
+                    const std::function<void()> &run, const std::function<void()> &reset)
+{
+    std::chrono::duration<double> elapsed{0};
+    std::size_t allocations = 0;
+    std::size_t runs = 0;
+    while ((runs < 3) || (elapsed.count() < options.minimumTime))
+    {
+        std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        run();
+        elapsed += std::chrono::steady_clock::now() - start;
+        allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        runs++;
+        reset();
+    }
+    double megabytesPerSecond = (double)bytes * runs / (1024.0 * 1024.0) / elapsed.count();
+    if (options.csv)
+    {
+        std::cout << corpus << "," << operation << "," << bytes << "," << std::fixed << std::setprecision(1)
+                  << megabytesPerSecond << "," << allocations / runs << "\n";
+    }
+    else
+    {
+        std::cout << std::left << std::setw(18) << corpus << std::setw(24) << operation << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << megabytesPerSecond << std::setw(14) << allocations / runs << "\n";
+    }
+}
+/// <summary>
+/// Run every benchmark on a corpus.
+/// </summary>
+/// <param name="options">Benchmark settings.</param>
+/// <param name="corpus">Corpus to use.</param>
+/// <returns></returns>
+static void benchmarkCorpus(const Options &options, const Corpus &corpus)
+{
+    JSON json;
+    JSONTranslator translator;
+    std::unique_ptr<JNode> jNode;
+    std::string result;
+    auto freeJNode = [&jNode]()
+    { jNode.reset(); };
+    auto freeResult = [&result]()
+    { std::string().swap(result); };
+    measure(options, corpus.name, "parseBuffer", corpus.json.size(), [&]()
+            { jNode = json.parseBuffer(corpus.json); }, freeJNode);
+    std::string fileName = (std::filesystem::temp_directory_path() / ("JSON_Benchmarks_" + std::to_string(std::hash<std::string>{}(corpus.name)) + ".json")).string();
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(corpus.json.data(), corpus.json.size());
+    }
+    measure(options, corpus.name, "parseFile", corpus.json.size(), [&]()
+            { jNode = json.parseFile(fileName); }, freeJNode);
+    std::filesystem::remove(fileName);
+    std::unique_ptr<JNode> parsed = json.parseBuffer(corpus.json);
+    std::size_t stringifiedSize = json.stringifyToBuffer(*parsed).size();
+    measure(options, corpus.name, "stringifyToBuffer", stringifiedSize, [&]()
+            { result = json.stringifyToBuffer(*parsed); }, freeResult);
+    parsed.reset();
+    measure(options, corpus.name, "stripWhiteSpaceBuffer", corpus.json.size(), [&]()
+            { result = json.stripWhiteSpaceBuffer(corpus.json); }, freeResult);
+    // The whole corpus is translated as one string
+    std::string escaped{translator.toEscapeSequences(corpus.json)};
+    measure(options, corpus.name, "toEscapeSequences", corpus.json.size(), [&]()
+            { result = translator.toEscapeSequences(corpus.json); }, freeResult);
+    measure(options, corpus.name, "fromEscapeSequences", escaped.size(), [&]()
+            { result = translator.fromEscapeSequences(escaped); }, freeResult);
+}
+/// <summary>
+/// Parse command line options.
+/// </summary>
+/// <param name="argc">Argument count.</param>
+/// <param name="argv">Arguments.</param>
+/// <param name="options">Benchmark settings.</param>
+/// <returns>true if options valid.</returns>
+static bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if ((std::strcmp(argv[arg], "--size") == 0) && (arg + 1 < argc))
+        {
+            options.corpusSize = std::strtoul(argv[++arg], nullptr, 10) * 1024 * 1024;
+        }
+        else if ((std::strcmp(argv[arg], "--min-time") == 0) && (arg + 1 < argc))
+        {
+            options.minimumTime = std::strtod(argv[++arg], nullptr);
+        }
+        else if (std::strcmp(argv[arg], "--csv") == 0)
+        {
+            options.csv = true;
+        }
+        else
+        {
+            return (false);
+        }
+    }
+    return (options.corpusSize != 0);
+}
+// ============
+// Benchmarks
+// ============
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--size MB] [--min-time seconds] [--csv]\n";
+        return (EXIT_FAILURE);
+    }
+    try
+    {
+        std::mt19937 random(1964);
+        std::vector<Corpus> corpora;
+        corpora.push_back({"wide objects", generateWideObjects(options.corpusSize, random)});
+        corpora.push_back({"deep nesting", generateDeepNesting(options.corpusSize, random)});
+        corpora.push_back({"numeric arrays", generateNumericArrays(options.corpusSize, random)});
+        corpora.push_back({"string heavy", generateStringHeavy(options.corpusSize, random)});
+        corpora.push_back({"unicode heavy", generateUnicodeHeavy(options.corpusSize, random)});
+        if (options.csv)
+        {
+            std::cout << "corpus,operation,bytes,mb_per_second,allocations_per_document\n";
+        }
+        else
+        {
+            std::cout << "JSON Benchmarks (build type \"" << JSON_BENCHMARK_BUILD_TYPE << "\", "
+                      << options.corpusSize / (1024 * 1024) << " MB corpora)\n\n";
+            std::cout << std::left << std::setw(18) << "Corpus" << std::setw(24) << "Operation" << std::right
+                      << std::setw(10) << "MB/s" << std::setw(14) << "Allocations" << "\n";
+        }
+        for (const Corpus &corpus : corpora)
+        {
+            benchmarkCorpus(options, corpus);
+        }
+    }
+    catch (std::exception &ex)
+    {
+        std::cerr << "Benchmark failed: " << ex.what() << "\n";
+        return (EXIT_FAILURE);
+    }
+    return (EXIT_SUCCESS);
+}
@@ -29,7 +29,6 @@
 //
 #include <stdexcept>
 #include <utility>
-#include <set>
 #include <iomanip>
 #include <iostream>
 // =========
@@ -47,7 +46,6 @@ namespace H4
     // PRIVATE STATIC VARIABLES
     // ========================
     static JSONTranslator defaultTranslator;
-    static std::set<char> validNumeric{'1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '.', '-', '+', 'E', 'e'};
     // =======================
     // PUBLIC STATIC VARIABLES
     // =======================
@@ -55,299 +53,372 @@ namespace H4
     // PRIVATE METHODS
     // ===============
     /// <summary>
-    /// Move to next non-whitespace character in JSON encoded source stream.
+    /// Work buffer and stacks kept for the calling thread.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
-    /// <returns></returns>
-    inline void JSON::ignoreWhiteSpace(ISource &source)
+    /// <returns>Work state of thread.</returns>
+    JSON::WorkState &JSON::threadWorkState()
     {
-        while (source.bytesToParse() && std::iswspace(source.currentByte()))
-        {
-            source.moveToNextByte();
-        }
+        static thread_local WorkState workState;
+        return (workState);
     }
     /// <summary>
-    /// Extract a string from a JSON encoded source stream.
+    /// Keep whichever of a thread's work buffer/stack and one handed back
+    /// has the larger capacity, emptied ready for the next call.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
-    /// <returns>Extracted string</returns>
-    std::string JSON::extractString(ISource &source)
+    /// <param name="kept">Work buffer/stack kept for thread.</param>
+    /// <param name="handedBack">Work buffer/stack handed back.</param>
+    /// <returns></returns>
+    template <typename T>
+    static void keepLarger(T &kept, T &handedBack)
     {
-        m_workBuffer.clear();
-        source.moveToNextByte();
-        while (source.bytesToParse() && source.currentByte() != '"')
+        if (handedBack.capacity() > kept.capacity())
         {
-            if (source.currentByte() == '\\')
-            {
-                m_workBuffer += source.currentByte();
-                source.moveToNextByte();
-            }
-            m_workBuffer += source.currentByte();
-            source.moveToNextByte();
+            kept.swap(handedBack);
         }
-        if (!source.bytesToParse())
-        {
-            throw JSON::SyntaxError();
-        }
-        source.moveToNextByte();
-        return (m_workBuffer);
+        kept.clear();
     }
     /// <summary>
-    /// Parse a string from a JSON source stream.
+    /// Parse JSON from a contiguous source into an arena, every JNode (and
+    /// its strings/containers) created during the parse being allocated
+    /// from it.
     /// </summary>
     /// <param name="source">Source for JSON encoded bytes.</param>
-    /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseString(ISource &source)
+    /// <param name="arena">Arena to allocate JNodes from.</param>
+    /// <returns>Root of JNode structure.</returns>
+    JNode *JSON::parseJNodesInArena(IndexedSource &source, std::pmr::memory_resource *arena)
     {
-        return (std::make_unique<JNodeString>(m_jsonTranslator->fromEscapeSequences(extractString(source))));
-    }
-    /// <summary>
-    /// Parse a number from a JSON source stream.
-    /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
-    /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseNumber(ISource &source)
-    {
-        m_workBuffer.clear();
-        m_workBuffer += source.currentByte();
-        source.moveToNextByte();
-        while (source.bytesToParse() && validNumeric.count(source.currentByte()) > 0)
+        m_arena = arena;
+        try
         {
-            m_workBuffer += source.currentByte();
-            source.moveToNextByte();
+            JNode *jNodeRoot = parseJNodes(source).release();
+            m_arena = nullptr;
+            return (jNodeRoot);
         }
-        // Throw error if not valid integer or floating point
-        char *end;
-        std::strtoll(m_workBuffer.c_str(), &end, 10);
-        if (*end != '\0')
+        catch (...)
         {
-            std::strtod(m_workBuffer.c_str(), &end);
-            if (*end != '\0')
-            {
-                throw JSON::SyntaxError();
-            }
+            m_arena = nullptr;
+            throw;
         }
-        return (std::make_unique<JNodeNumber>(m_workBuffer));
     }
     /// <summary>
-    /// Parse a boolean from a JSON source stream.
+    /// Parse JSON from a contiguous source into a compact JValue tree whose
+    /// strings and child values are allocated from an arena.
     /// </summary>
     /// <param name="source">Source for JSON encoded bytes.</param>
-    /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseBoolean(ISource &source)
+    /// <param name="arena">Arena for out of line JValue storage.</param>
+    /// <returns>Root JValue.</returns>
+    JValue JSON::parseJValuesInArena(IndexedSource &source, std::pmr::memory_resource *arena)
     {
-        m_workBuffer.clear();
-        m_workBuffer += source.currentByte();
-        source.moveToNextByte();
-        while (source.bytesToParse() && std::isalpha(source.currentByte()))
-        {
-            m_workBuffer += source.currentByte();
-            source.moveToNextByte();
-        }
-        if (m_workBuffer == "true")
+        m_arena = arena;
+        m_jValueStack.clear();
+        try
         {
-            return (std::make_unique<JNodeBoolean>(true));
+            JValue jValueRoot = parseJValues(source);
+            m_arena = nullptr;
+            return (jValueRoot);
         }
-        else if (m_workBuffer == "false")
+        catch (...)
         {
-            return (std::make_unique<JNodeBoolean>(false));
+            m_arena = nullptr;
+            throw;
         }
-        throw JSON::SyntaxError();
     }
     /// <summary>
-    /// Parse a null from a JSON source stream.
+    /// Write a number to a destination in its shortest form.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name=numeric>Number to write</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseNull(ISource &source)
+    void JSON::stringifyNumber(const JNumeric &numeric, IDestination &destination)
     {
-        m_workBuffer.clear();
-        m_workBuffer += source.currentByte();
-        source.moveToNextByte();
-        while (source.bytesToParse() && std::isalpha(source.currentByte()))
-        {
-            m_workBuffer += source.currentByte();
-            source.moveToNextByte();
-        }
-        if (m_workBuffer == "null")
-        {
-            return (std::make_unique<JNodeNull>());
-        }
-        throw JSON::SyntaxError();
+        char buffer[JNumeric::kMaxTextLength];
+        destination.addBytes(std::string_view(buffer, numeric.toChars(buffer) - buffer));
     }
     /// <summary>
-    /// Parse an object from a JSON source stream.
+    /// Write a packed numeric array to a destination. The numbers are
+    /// formatted into a local buffer which is passed on whenever it fills
+    /// rather than writing each number (and comma) separately.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name=jNodeArray>Packed array to write</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseObject(ISource &source)
+    void JSON::stringifyPackedNumbers(const JNodeArray &jNodeArray, IDestination &destination)
     {
-        JNodeObject object;
-        do
+        char buffer[4096];
+        char *next = buffer;
+        *next++ = '[';
+        for (std::size_t index = 0; index < jNodeArray.getPackedNumbers().size(); index++)
         {
-            source.moveToNextByte();
-            ignoreWhiteSpace(source);
-            std::string key = m_jsonTranslator->fromEscapeSequences(extractString(source));
-            ignoreWhiteSpace(source);
-            if (source.currentByte() != ':')
+            if ((buffer + sizeof(buffer) - next) <= (std::ptrdiff_t)JNumeric::kMaxTextLength)
             {
-                throw JSON::SyntaxError();
+                destination.addBytes(std::string_view(buffer, next - buffer));
+                next = buffer;
             }
-            source.moveToNextByte();
-            ignoreWhiteSpace(source);
-            object.addEntry(key, parseJNodes(source));
-            ignoreWhiteSpace(source);
-        } while (source.currentByte() == ',');
-        if (source.currentByte() != '}')
-        {
-            throw JSON::SyntaxError();
+            next = jNodeArray.getPackedNumeric(index).toChars(next);
+            *next++ = ',';
         }
-        source.moveToNextByte();
-        return (std::make_unique<JNodeObject>(std::move(object)));
+        next[-1] = ']';
+        destination.addBytes(std::string_view(buffer, next - buffer));
     }
     /// <summary>
-    /// Parse an array from a JSON source stream.
+    /// Write a string (or key) to a destination quoted and with any
+    /// characters that need it escaped.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name=string>String to write</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseArray(ISource &source)
+    void JSON::stringifyString(std::string_view string, IDestination &destination)
     {
-        JNodeArray array;
-        do
-        {
-            source.moveToNextByte();
-            ignoreWhiteSpace(source);
-            array.addEntry(parseJNodes(source));
-            ignoreWhiteSpace(source);
-        } while (source.currentByte() == ',');
-        if (source.currentByte() != ']')
-        {
-            throw JSON::SyntaxError();
-        }
-        source.moveToNextByte();
-        return (std::make_unique<JNodeArray>(std::move(array)));
+        destination.addByte('"');
+        destination.addBytes(m_jsonTranslator->toEscapeSequences(string));
+        destination.addByte('"');
     }
     /// <summary>
-    /// Recursively parse JSON source stream producing a JNode structure
-    /// reprentation  of it.
+    /// Traverse JNode structure encoding it into JSON on the destination
+    /// stream passed in. Objects/arrays being written are kept on an
+    /// explicit stack along with the next entry to write rather than
+    /// recursing for each level of nesting.
     /// </summary>
-    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name=jNodeRoot>JNode structure to be traversed</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    std::unique_ptr<JNode> JSON::parseJNodes(ISource &source)
+    void JSON::stringifyJNodes(const JNode &jNodeRoot, IDestination &destination)
     {
-        ignoreWhiteSpace(source);
-        switch (source.currentByte())
+        std::size_t base = m_stringifyStack.size();
+        const JNode *jNode = &jNodeRoot;
+        try
         {
-        case '"':
-            return (parseString(source));
-        case 't':
-        case 'f':
-            return (parseBoolean(source));
-        case 'n':
-            return (parseNull(source));
-        case '{':
-            return (parseObject(source));
-        case '[':
-            return (parseArray(source));
-        case '-':
-        case '+':
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            return (parseNumber(source));
+            while (jNode != nullptr)
+            {
+                switch (jNode->nodeType)
+                {
+                case JNodeType::number:
+                    if (!JNodeRef<JNodeNumber>(*jNode).getText().empty())
+                    {
+                        destination.addBytes(JNodeRef<JNodeNumber>(*jNode).getText());
+                    }
+                    else
+                    {
+                        stringifyNumber(JNodeRef<JNodeNumber>(*jNode).getNumeric(), destination);
+                    }
+                    break;
+                case JNodeType::string:
+                    stringifyString(JNodeRef<JNodeString>(*jNode).getString(), destination);
+                    break;
+                case JNodeType::boolean:
+                    destination.addBytes(JNodeRef<JNodeBoolean>(*jNode).getBoolean() ? "true" : "false");
+                    break;
+                case JNodeType::null:
+                    destination.addBytes("null");
+                    break;
+                case JNodeType::object:
+                    destination.addByte('{');
+                    m_stringifyStack.push_back(StringifyFrame{jNode, nullptr, 0});
+                    break;
+                case JNodeType::array:
+                    if (JNodeRef<JNodeArray>(*jNode).isPacked())
+                    {
+                        stringifyPackedNumbers(JNodeRef<JNodeArray>(*jNode), destination);
+                        break;
+                    }
+                    destination.addByte('[');
+                    m_stringifyStack.push_back(StringifyFrame{jNode, nullptr, 0});
+                    break;
+                default:
+                    throw std::runtime_error("Unknown JNode type encountered during stringification.");
+                }
+                // Next is the first unwritten entry of the innermost open
+                // object/array; any that are finished are closed.
+                jNode = nullptr;
+                while (m_stringifyStack.size() > base)
+                {
+                    StringifyFrame &frame = m_stringifyStack.back();
+                    if (frame.jNode->nodeType == JNodeType::object)
+                    {
+                        auto &entries = JNodeRef<JNodeObject>(*frame.jNode).getEntries();
+                        if (frame.next < entries.size())
+                        {
+                            if (frame.next > 0)
+                            {
+                                destination.addByte(',');
+                            }
+                            auto &entry = *(entries.begin() + frame.next++);
+                            stringifyString(entry.key, destination);
+                            destination.addByte(':');
+                            jNode = entry.value.get();
+                            break;
+                        }
+                        destination.addByte('}');
+                    }
+                    else
+                    {
+                        auto &elements = JNodeRef<JNodeArray>(*frame.jNode).getArray();
+                        if (frame.next < elements.size())
+                        {
+                            if (frame.next > 0)
+                            {
+                                destination.addByte(',');
+                            }
+                            jNode = elements[frame.next++].get();
+                            break;
+                        }
+                        destination.addByte(']');
+                    }
+                    m_stringifyStack.pop_back();
+                }
+            }
+        }
+        catch (...)
+        {
+            m_stringifyStack.resize(base);
+            throw;
         }
-        throw JSON::SyntaxError();
     }
     /// <summary>
-    /// Recursively traverse JNode structure encoding it into JSON on
-    /// the destination stream passed in.
+    /// Traverse JValue tree encoding it into JSON on the destination stream
+    /// passed in. Objects/arrays being written are kept on an explicit
+    /// stack as for stringifyJNodes().
     /// </summary>
-    /// <param name=jNode>JNode structure to be traversed</param>
+    /// <param name=jValueRoot>JValue tree to be traversed</param>
     /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    void JSON::stringifyJNodes(JNode *jNode, IDestination &destination)
+    void JSON::stringifyJValues(const JValue &jValueRoot, IDestination &destination)
     {
-        switch (jNode->nodeType)
+        std::size_t base = m_stringifyStack.size();
+        const JValue *jValue = &jValueRoot;
+        try
         {
-        case JNodeType::number:
-            destination.addBytes(JNodeRef<JNodeNumber>(*jNode).getNumber());
-            break;
-        case JNodeType::string:
-            destination.addBytes("\"" + m_jsonTranslator->toEscapeSequences(JNodeRef<JNodeString>(*jNode).getString()) + "\"");
-            break;
-        case JNodeType::boolean:
-            destination.addBytes(JNodeRef<JNodeBoolean>(*jNode).getBoolean() ? "true" : "false");
-            break;
-        case JNodeType::null:
-            destination.addBytes("null");
-            break;
-        case JNodeType::object:
-        {
-            int commaCount = JNodeRef<JNodeObject>(*jNode).size() - 1;
-            destination.addBytes("{");
-            for (auto key : JNodeRef<JNodeObject>(*jNode).getKeys())
+            while (jValue != nullptr)
             {
-                destination.addBytes("\"" + m_jsonTranslator->toEscapeSequences(key) + "\"" + ":");
-                stringifyJNodes(JNodeRef<JNodeObject>(*jNode).getEntry(key), destination);
-                if (commaCount-- > 0)
+                switch (jValue->getNodeType())
                 {
-                    destination.addBytes(",");
+                case JNodeType::number:
+                    stringifyNumber(jValue->getNumeric(), destination);
+                    break;
+                case JNodeType::string:
+                    stringifyString(jValue->getString(), destination);
+                    break;
+                case JNodeType::boolean:
+                    destination.addBytes(jValue->getBoolean() ? "true" : "false");
+                    break;
+                case JNodeType::null:
+                    destination.addBytes("null");
+                    break;
+                case JNodeType::object:
+                    destination.addByte('{');
+                    m_stringifyStack.push_back(StringifyFrame{nullptr, jValue, 0});
+                    break;
+                case JNodeType::array:
+                    destination.addByte('[');
+                    m_stringifyStack.push_back(StringifyFrame{nullptr, jValue, 0});
+                    break;
+                default:
+                    throw std::runtime_error("Unknown JNode type encountered during stringification.");
                 }
-            }
-            destination.addBytes("}");
-            break;
-        }
-        case JNodeType::array:
-        {
-            int commaCount = JNodeRef<JNodeArray>(*jNode).size() - 1;
-            destination.addBytes("[");
-            for (auto &bNodeEntry : JNodeRef<JNodeArray>(*jNode).getArray())
-            {
-                stringifyJNodes(bNodeEntry.get(), destination);
-                if (commaCount-- > 0)
+                // Next is the first unwritten entry of the innermost open
+                // object/array; any that are finished are closed.
+                jValue = nullptr;
+                while (m_stringifyStack.size() > base)
                 {
-                    destination.addBytes(",");
+                    StringifyFrame &frame = m_stringifyStack.back();
+                    if (frame.next < (std::size_t)frame.jValue->size())
+                    {
+                        if (frame.next > 0)
+                        {
+                            destination.addByte(',');
+                        }
+                        if (frame.jValue->getNodeType() == JNodeType::object)
+                        {
+                            stringifyString(frame.jValue->getKey((int)frame.next), destination);
+                            destination.addByte(':');
+                        }
+                        jValue = &(*frame.jValue)[(int)frame.next++];
+                        break;
+                    }
+                    destination.addByte((frame.jValue->getNodeType() == JNodeType::object) ? '}' : ']');
+                    m_stringifyStack.pop_back();
                 }
             }
-            destination.addBytes("]");
-            break;
         }
-        default:
-            throw std::runtime_error("Unknown JNode type encountered during stringification.");
+        catch (...)
+        {
+            m_stringifyStack.resize(base);
+            throw;
         }
     }
     /// <summary>
-    /// Remove all whitespace characters from a JSON source stream and
-    /// write them out to a JSON destination stream.
+    /// Encode a JSONTape into JSON on the destination stream passed in. The
+    /// tape is already in document order so it is written in one pass,
+    /// only the entries of the objects/arrays still open being kept.
     /// </summary>
-    /// <param name=source>JSON source stream</param>
-    /// <param name=jNode>JSON destination stream</param>
+    /// <param name=tape>JSONTape to be written</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
     /// <returns></returns>
-    void JSON::stripWhiteSpace(ISource &source, IDestination &destination)
+    void JSON::stringifyTape(const JSONTape &tape, IDestination &destination)
     {
-        while (source.bytesToParse())
+        const std::vector<JTapeEntry> &entries = tape.entries();
+        std::vector<std::size_t> open;
+        std::size_t index = 0;
+        bool first = true;
+        do
         {
-            ignoreWhiteSpace(source);
-            if (source.bytesToParse())
+            if (!open.empty())
             {
-                if (source.currentByte() == '"')
+                const JTapeEntry &container = entries[open.back()];
+                if (index == container.payload)
+                {
+                    destination.addByte((container.type == JNodeType::object) ? '}' : ']');
+                    open.pop_back();
+                    first = false;
+                    continue;
+                }
+                if (!first)
                 {
-                    destination.addBytes("\"" + extractString(source) + "\"");
+                    destination.addByte(',');
                 }
-                else
+                if (container.type == JNodeType::object)
                 {
-                    destination.addBytes(std::string(1, source.currentByte()));
-                    source.moveToNextByte();
+                    stringifyString(tape.strings().substr(entries[index].payload, entries[index].size), destination);
+                    destination.addByte(':');
+                    index++;
                 }
             }
-        }
+            const JTapeEntry &entry = entries[index];
+            first = false;
+            switch (entry.type)
+            {
+            case JNodeType::object:
+                destination.addByte('{');
+                open.push_back(index);
+                first = true;
+                break;
+            case JNodeType::array:
+                destination.addByte('[');
+                open.push_back(index);
+                first = true;
+                break;
+            case JNodeType::number:
+            {
+                JNumeric numeric;
+                numeric.kind = (JNumeric::Kind)entry.info;
+                std::memcpy(&numeric.integer, &entry.payload, sizeof(numeric.integer));
+                stringifyNumber(numeric, destination);
+                break;
+            }
+            case JNodeType::string:
+                stringifyString(tape.strings().substr(entry.payload, entry.size), destination);
+                break;
+            case JNodeType::boolean:
+                destination.addBytes((entry.payload != 0) ? "true" : "false");
+                break;
+            case JNodeType::null:
+                destination.addBytes("null");
+                break;
+            default:
+                throw std::runtime_error("Unknown JNode type encountered during stringification.");
+            }
+            index++;
+        } while (!open.empty());
     }
     // ==============
     // PUBLIC METHODS
@@ -369,21 +440,65 @@ namespace H4
         }
     }
     /// <summary>
-    /// Create JNode structure by recursively parsing JSON in a buffer.
+    /// JSON copy constructor; only the settings (translator, whether number
+    /// text is kept, whether numeric arrays are packed and the maximum
+    /// nesting depth) are copied. Each public method works on a copy like
+    /// this (see WorkScope) so no work state is ever shared and one JSON
+    /// object (whose settings are not being changed) can be used by
+    /// several threads at once.
+    /// </summary>
+    /// <param name=other>JSON object to copy.</param>
+    /// <returns></returns>
+    JSON::JSON(const JSON &other)
+        : m_jsonTranslator(other.m_jsonTranslator), m_keepNumberText(other.m_keepNumberText), m_packNumbers(other.m_packNumbers),
+          m_maxNestingDepth(other.m_maxNestingDepth)
+    {
+    }
+    /// <summary>
+    /// Work scope constructor; the copy of the JSON object is given the
+    /// work buffer and stacks kept for the thread.
+    /// </summary>
+    /// <param name=settings>JSON object whose settings are used.</param>
+    /// <returns></returns>
+    JSON::WorkScope::WorkScope(const JSON &settings) : json(settings)
+    {
+        WorkState &workState = threadWorkState();
+        json.m_workBuffer.swap(workState.workBuffer);
+        json.m_jValueStack.swap(workState.jValueStack);
+        json.m_jNodeStack.swap(workState.jNodeStack);
+        json.m_stringifyStack.swap(workState.stringifyStack);
+    }
+    /// <summary>
+    /// Work scope destructor; the work buffer and stacks are handed back to
+    /// the thread for the next call.
+    /// </summary>
+    JSON::WorkScope::~WorkScope()
+    {
+        WorkState &workState = threadWorkState();
+        keepLarger(workState.workBuffer, json.m_workBuffer);
+        keepLarger(workState.jValueStack, json.m_jValueStack);
+        keepLarger(workState.jNodeStack, json.m_jNodeStack);
+        keepLarger(workState.stringifyStack, json.m_stringifyStack);
+    }
+    /// <summary>
+    /// Create JNode structure by recursively parsing JSON in a buffer. A
+    /// structural index is built for the buffer first and used to skip
+    /// whitespace and strings during the parse.
     /// </summary>
     /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
     /// <returns>JNode structure.</returns>
-    std::unique_ptr<JNode> JSON::parseBuffer(const std::string &jsonBuffer)
+    std::unique_ptr<JNode> JSON::parseBuffer(std::string_view jsonBuffer)
     {
         if (jsonBuffer.empty())
         {
             throw std::invalid_argument("Empty string passed to be parsed.");
         }
-        BufferSource source(jsonBuffer);
-        return (parseJNodes(source));
+        IndexedSource source(jsonBuffer);
+        return (WorkScope(*this).json.parseJNodes(source));
     }
     /// <summary>
-    /// Create JNode structure by recursively parsing JSON in a file.
+    /// Create JNode structure by recursively parsing JSON in a file. The
+    /// file is memory mapped (or read in whole) and parsed as one span.
     /// </summary>
     /// <param name=sourceFileName>JSON source file name</param>
     /// <returns>JNode structure.</returns>
@@ -393,8 +508,9 @@ namespace H4
         {
             throw std::invalid_argument("Empty file name passed to be parsed.");
         }
-        FileSource source(sourceFileName);
-        return (parseJNodes(source));
+        MappedFileSource file(sourceFileName);
+        IndexedSource source(file.remainingBytes());
+        return (WorkScope(*this).json.parseJNodes(source));
     }
     /// <summary>
     /// Recursively parse JNode structure and building its JSON before returning it.
@@ -407,9 +523,7 @@ namespace H4
         {
             throw std::invalid_argument("Nullptr passed as JNode root to be stringified.");
         }
-        BufferDestination destination;
-        stringifyJNodes(jNodeRoot.get(), destination);
-        return (destination.getBuffer());
+        return (stringifyToBuffer(*jNodeRoot));
     }
     /// <summary>
     /// Recursively parse JNode structure and building its JSON and writing it to a file.
@@ -423,24 +537,23 @@ namespace H4
         {
             throw std::invalid_argument("Nullptr passed as JNode root to be stringified.");
         }
-        if (destinationFileName.empty())
-        {
-            throw std::invalid_argument("Empty file name passed to be stringified.");
-        }
-        FileDestination destination(std::move(destinationFileName));
-        stringifyJNodes(jNodeRoot.get(), destination);
+        stringifyToFile(*jNodeRoot, destinationFileName);
     }
     /// <summary>
     /// Remove all whitespace from a JSON buffer.
     /// </summary>
     /// <param name="jsonBuffer">Buffer of JSON</param>
     /// <returns>Whitespace free JSON.</returns>
-    std::string JSON::stripWhiteSpaceBuffer(const std::string &jsonBuffer)
+    std::string JSON::stripWhiteSpaceBuffer(std::string_view jsonBuffer)
     {
-        BufferSource source(jsonBuffer);
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty source buffer passed to be parsed.");
+        }
+        SpanSource source(jsonBuffer);
         BufferDestination destination;
-        stripWhiteSpace(source, destination);
-        return (destination.getBuffer());
+        WorkScope(*this).json.stripWhiteSpace(source, destination);
+        return (std::move(destination.getBuffer()));
     }
     /// <summary>
     /// Create JNode structure by recursively parsing JSON on the source stream.
@@ -449,7 +562,51 @@ namespace H4
     /// <returns>JNode structure.</returns>
     std::unique_ptr<JNode> JSON::parse(ISource &source)
     {
-        return (parseJNodes(source));
+        return (WorkScope(*this).json.parseJNodes(source));
+    }
+    /// <summary>
+    /// Parse JSON on the source stream raising events on a handler rather
+    /// than building a JNode structure.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <returns></returns>
+    void JSON::parse(ISource &source, IHandler &handler)
+    {
+        WorkScope(*this).json.parseEvents(source, handler);
+    }
+    /// <summary>
+    /// Parse JSON in a buffer raising events on a handler rather than
+    /// building a JNode structure. No structural index is built so memory
+    /// use does not grow with the size of the buffer.
+    /// </summary>
+    /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <returns></returns>
+    void JSON::parseBuffer(std::string_view jsonBuffer, IHandler &handler)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        SpanSource source(jsonBuffer);
+        WorkScope(*this).json.parseEvents(source, handler);
+    }
+    /// <summary>
+    /// Parse JSON in a file raising events on a handler rather than building
+    /// a JNode structure. The file is memory mapped (or read in whole).
+    /// </summary>
+    /// <param name=sourceFileName>JSON source file name</param>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <returns></returns>
+    void JSON::parseFile(const std::string &sourceFileName, IHandler &handler)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource source(sourceFileName);
+        WorkScope(*this).json.parseEvents<SpanSource>(source, handler);
     }
     /// <summary>
     /// Recursively parse JNode structure and building its JSON in destination stream.
@@ -459,6 +616,225 @@ namespace H4
     /// <returns></returns>
     void JSON::stringify(std::unique_ptr<JNode> jNodeRoot, IDestination &destination)
     {
-        stringifyJNodes(jNodeRoot.get(), destination);
+        if (jNodeRoot == nullptr)
+        {
+            throw std::invalid_argument("Nullptr passed as JNode root to be stringified.");
+        }
+        stringify(*jNodeRoot, destination);
+    }
+    /// <summary>
+    /// Build the JSON for a JNode structure and return it; the structure is
+    /// left intact so may be stringified any number of times.
+    /// </summary>
+    /// <param name="jNodeRoot">Root of JNode structure.</param>
+    /// <returns>JSON string</returns>
+    std::string JSON::stringifyToBuffer(const JNode &jNodeRoot)
+    {
+        BufferDestination destination;
+        WorkScope(*this).json.stringifyJNodes(jNodeRoot, destination);
+        return (std::move(destination.getBuffer()));
+    }
+    /// <summary>
+    /// Build the JSON for a JNode structure and write it to a file; the
+    /// structure is left intact.
+    /// </summary>
+    /// <param name="jNodeRoot">Root of JNode structure.</param>
+    /// <param name="destination">Destination JSON file.</param>
+    /// <returns></returns>
+    void JSON::stringifyToFile(const JNode &jNodeRoot, const std::string &destinationFileName)
+    {
+        if (destinationFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be stringified.");
+        }
+        FileDestination destination(destinationFileName);
+        WorkScope(*this).json.stringifyJNodes(jNodeRoot, destination);
+        destination.flush();
+    }
+    /// <summary>
+    /// Build the JSON for a JNode structure in a destination stream; the
+    /// structure is left intact.
+    /// </summary>
+    /// <param name="jNodeRoot">Root of JNode structure.</param>
+    /// <param name=desination>destination stream for stringified JSON</param>
+    /// <returns></returns>
+    void JSON::stringify(const JNode &jNodeRoot, IDestination &destination)
+    {
+        WorkScope(*this).json.stringifyJNodes(jNodeRoot, destination);
+    }
+    /// <summary>
+    /// Create a JSONDocument by parsing JSON in a buffer; all of its JNodes
+    /// are allocated from the document arena.
+    /// </summary>
+    /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
+    /// <returns>JSONDocument containing JNode structure.</returns>
+    JSONDocument JSON::parseBufferToDocument(std::string_view jsonBuffer)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        JSONDocument document(jsonBuffer.size());
+        IndexedSource source(jsonBuffer);
+        document.m_root = WorkScope(*this).json.parseJNodesInArena(source, document.arena());
+        return (document);
+    }
+    /// <summary>
+    /// Create a JSONDocument by parsing JSON in a file; all of its JNodes
+    /// are allocated from the document arena.
+    /// </summary>
+    /// <param name=sourceFileName>JSON source file name</param>
+    /// <returns>JSONDocument containing JNode structure.</returns>
+    JSONDocument JSON::parseFileToDocument(const std::string &sourceFileName)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource file(sourceFileName);
+        IndexedSource source(file.remainingBytes());
+        JSONDocument document(source.bytesRemaining());
+        document.m_root = WorkScope(*this).json.parseJNodesInArena(source, document.arena());
+        return (document);
+    }
+    /// <summary>
+    /// Build the JSON for a JSONDocument and return it; the document is
+    /// left intact.
+    /// </summary>
+    /// <param name="document">JSONDocument to stringify.</param>
+    /// <returns>JSON string</returns>
+    std::string JSON::stringifyToBuffer(const JSONDocument &document)
+    {
+        BufferDestination destination;
+        WorkScope(*this).json.stringifyJNodes(document.root(), destination);
+        return (std::move(destination.getBuffer()));
+    }
+    /// <summary>
+    /// Build the JSON for a JSONDocument and write it to a file; the document
+    /// is left intact.
+    /// </summary>
+    /// <param name="document">JSONDocument to stringify.</param>
+    /// <param name="destination">Destination JSON file.</param>
+    /// <returns></returns>
+    void JSON::stringifyToFile(const JSONDocument &document, const std::string &destinationFileName)
+    {
+        if (destinationFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be stringified.");
+        }
+        FileDestination destination(destinationFileName);
+        WorkScope(*this).json.stringifyJNodes(document.root(), destination);
+        destination.flush();
+    }
+    /// <summary>
+    /// Create a compact JValue tree by parsing JSON in a buffer.
+    /// </summary>
+    /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
+    /// <returns>JValueDocument containing JValue tree.</returns>
+    JValueDocument JSON::parseBufferToJValues(std::string_view jsonBuffer)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        JValueDocument document(jsonBuffer.size() / 2);
+        IndexedSource source(jsonBuffer);
+        document.m_root = WorkScope(*this).json.parseJValuesInArena(source, document.arena());
+        return (document);
+    }
+    /// <summary>
+    /// Create a compact JValue tree by parsing JSON in a file.
+    /// </summary>
+    /// <param name=sourceFileName>JSON source file name</param>
+    /// <returns>JValueDocument containing JValue tree.</returns>
+    JValueDocument JSON::parseFileToJValues(const std::string &sourceFileName)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource file(sourceFileName);
+        IndexedSource source(file.remainingBytes());
+        JValueDocument document(source.bytesRemaining() / 2);
+        document.m_root = WorkScope(*this).json.parseJValuesInArena(source, document.arena());
+        return (document);
+    }
+    /// <summary>
+    /// Build the JSON for a compact JValue tree and return it.
+    /// </summary>
+    /// <param name="document">JValueDocument to stringify.</param>
+    /// <returns>JSON string</returns>
+    std::string JSON::stringifyToBuffer(const JValueDocument &document)
+    {
+        BufferDestination destination;
+        WorkScope(*this).json.stringifyJValues(document.root(), destination);
+        return (std::move(destination.getBuffer()));
+    }
+    /// <summary>
+    /// Build the JSON for a frozen JSONTape and return it.
+    /// </summary>
+    /// <param name="tape">JSONTape to stringify.</param>
+    /// <returns>JSON string</returns>
+    std::string JSON::stringifyToBuffer(const JSONTape &tape)
+    {
+        tape.root(); // Throws if nothing has been frozen into the tape
+        BufferDestination destination;
+        WorkScope(*this).json.stringifyTape(tape, destination);
+        return (std::move(destination.getBuffer()));
+    }
+    /// <summary>
+    /// Build the JSON for a frozen JSONTape and write it to a file.
+    /// </summary>
+    /// <param name="tape">JSONTape to stringify.</param>
+    /// <param name="destination">Destination JSON file.</param>
+    /// <returns></returns>
+    void JSON::stringifyToFile(const JSONTape &tape, const std::string &destinationFileName)
+    {
+        if (destinationFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be stringified.");
+        }
+        tape.root(); // Throws if nothing has been frozen into the tape
+        FileDestination destination(destinationFileName);
+        WorkScope(*this).json.stringifyTape(tape, destination);
+        destination.flush();
+    }
+    /// <summary>
+    /// Set whether parsed JNodeNumbers keep their original text (returned
+    /// by getNumber() and written when stringified) as well as their
+    /// native value. By default only the value is kept and numbers are
+    /// written in their shortest form.
+    /// </summary>
+    /// <param name="keepNumberText">true then keep number text.</param>
+    /// <returns></returns>
+    void JSON::keepNumberText(bool keepNumberText)
+    {
+        m_keepNumberText = keepNumberText;
+    }
+    /// <summary>
+    /// Set whether arrays whose elements are all numbers are parsed into
+    /// packed storage (see JNodeArray) rather than a JNodeNumber per
+    /// element. Off by default, as reading the elements of a packed array
+    /// unpacks it even through a const reference. Numbers are never packed
+    /// while their text is being kept.
+    /// </summary>
+    /// <param name="packNumbers">true then pack numeric arrays.</param>
+    /// <returns></returns>
+    void JSON::packNumbers(bool packNumbers)
+    {
+        m_packNumbers = packNumbers;
+    }
+    /// <summary>
+    /// Set the maximum depth to which objects/arrays may be nested in JSON
+    /// being parsed (kDefaultMaxNestingDepth by default); JSON nested any
+    /// deeper is reported as a syntax error. Parsing and stringifying
+    /// JNodes keeps an explicit stack on the heap so deep nesting does not
+    /// use up the native stack.
+    /// </summary>
+    /// <param name="maxNestingDepth">Maximum nesting depth.</param>
+    /// <returns></returns>
+    void JSON::maxNestingDepth(std::size_t maxNestingDepth)
+    {
+        m_maxNestingDepth = maxNestingDepth;
     }
 } // namespace H4
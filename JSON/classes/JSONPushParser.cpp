@@ -0,0 +1,483 @@
+//
+// Class: JSONPushParser
+//
+// Description: Incremental (push) JSON parser. JSON is fed in chunks of
+// any size as it arrives (eg. from a socket) and parsed as far as it goes
+// by an explicit state machine, any partial string, number or literal at
+// the end of a chunk being carried over to the next. Events are raised on
+// a JSON::IHandler as values complete or, if no handler is given, a JNode
+// structure is built that can be taken once the value is complete. So the
+// parse overlaps with receiving and the whole message is never buffered.
+// Numbers and literals are only known to be complete when followed by
+// another byte so finish() must be called at end of input if the top level
+// value could be one. The grammar and nesting depth limit are the same as
+// for JSON::parseBuffer().
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSONPushParser.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <cctype>
+#include <cmath>
+#include <cwctype>
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    //
+    // Parse event handler that builds a JNode structure.
+    //
+    struct JSONPushParser::JNodeBuilder : JSON::IHandler
+    {
+    public:
+        void onObjectStart() override
+        {
+            m_containers.push_back(addValue(std::make_unique<JNodeObject>()));
+        }
+        void onObjectEnd() override
+        {
+            m_containers.pop_back();
+        }
+        void onArrayStart() override
+        {
+            m_containers.push_back(addValue(std::make_unique<JNodeArray>()));
+        }
+        void onArrayEnd() override
+        {
+            m_containers.pop_back();
+        }
+        void onKey(std::string_view key) override
+        {
+            m_key = key;
+        }
+        void onString(std::string_view string) override
+        {
+            addValue(std::make_unique<JNodeString>(string));
+        }
+        void onNumber(const JNumeric &numeric, std::string_view text) override
+        {
+            // Text of numbers too large for a double is kept so it is not lost
+            if (m_keepNumberText || ((numeric.kind == JNumeric::Kind::floatingPoint) && !std::isfinite(numeric.floatingPoint)))
+            {
+                addValue(std::make_unique<JNodeNumber>(numeric, text));
+            }
+            else if (!m_packNumbers || m_containers.empty() || (m_containers.back()->nodeType != JNodeType::array) ||
+                     !JNodeRef<JNodeArray>(*m_containers.back()).packNumber(numeric))
+            {
+                addValue(std::make_unique<JNodeNumber>(numeric));
+            }
+        }
+        void onBoolean(bool boolean) override
+        {
+            addValue(std::make_unique<JNodeBoolean>(boolean));
+        }
+        void onNull() override
+        {
+            addValue(std::make_unique<JNodeNull>());
+        }
+        std::unique_ptr<JNode> m_root;
+        bool m_keepNumberText = false;
+        bool m_packNumbers = false;
+
+    private:
+        JNode *addValue(std::unique_ptr<JNode> jNode)
+        {
+            JNode *added = jNode.get();
+            if (m_containers.empty())
+            {
+                m_root = std::move(jNode);
+            }
+            else if (m_containers.back()->nodeType == JNodeType::object)
+            {
+                JNodeRef<JNodeObject>(*m_containers.back()).addEntry(m_key, std::move(jNode));
+            }
+            else
+            {
+                JNodeRef<JNodeArray>(*m_containers.back()).addEntry(std::move(jNode));
+            }
+            return (added);
+        }
+        std::vector<JNode *> m_containers;
+        std::string m_key;
+    };
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Byte can be part of a number.
+    /// </summary>
+    /// <param name="byte">Byte to check.</param>
+    /// <returns>true if byte can be in a number.</returns>
+    static inline bool isNumberByte(char byte)
+    {
+        return (std::isdigit(byte) || (byte == '.') || (byte == 'e') || (byte == 'E') || (byte == '+') || (byte == '-'));
+    }
+    /// <summary>
+    /// Start the value whose first byte is passed in.
+    /// </summary>
+    /// <param name="byte">First byte of value.</param>
+    /// <returns></returns>
+    void JSONPushParser::startValue(char byte)
+    {
+        m_token.clear();
+        switch (byte)
+        {
+        case '"':
+            m_stringIsKey = false;
+            m_escaped = false;
+            m_state = State::string;
+            return;
+        case '{':
+            pushContainer(byte);
+            m_handler->onObjectStart();
+            m_state = State::nextEntry;
+            return;
+        case '[':
+            pushContainer(byte);
+            m_handler->onArrayStart();
+            m_state = State::value;
+            return;
+        case 't':
+        case 'f':
+        case 'n':
+            m_token += byte;
+            m_state = State::literal;
+            return;
+        }
+        if ((byte == '-') || std::isdigit(byte))
+        {
+            m_token += byte;
+            m_state = State::number;
+            return;
+        }
+        throw JSON::SyntaxError();
+    }
+    /// <summary>
+    /// Open an object/array, checking the nesting depth limit of the JSON
+    /// object used (as parseBuffer() does).
+    /// </summary>
+    /// <param name="byte">Opening bracket.</param>
+    /// <returns></returns>
+    void JSONPushParser::pushContainer(char byte)
+    {
+        if (m_containers.size() >= m_json.m_maxNestingDepth)
+        {
+            throw JSON::SyntaxError("Maximum nesting depth exceeded.");
+        }
+        m_containers.push_back(byte);
+    }
+    /// <summary>
+    /// Close the current object/array.
+    /// </summary>
+    /// <param name="byte">Closing bracket.</param>
+    /// <returns></returns>
+    void JSONPushParser::closeContainer(char byte)
+    {
+        if (m_containers.empty() || ((byte == '}') != (m_containers.back() == '{')))
+        {
+            throw JSON::SyntaxError();
+        }
+        m_containers.pop_back();
+        if (byte == '}')
+        {
+            m_handler->onObjectEnd();
+        }
+        else
+        {
+            m_handler->onArrayEnd();
+        }
+        valueFinished();
+    }
+    /// <summary>
+    /// A value has been completed; the JSON is finished if it was the top
+    /// level value.
+    /// </summary>
+    /// <returns></returns>
+    void JSONPushParser::valueFinished()
+    {
+        m_state = m_containers.empty() ? State::finished : State::afterValue;
+    }
+    /// <summary>
+    /// Decode a completed string and pass it on as a key or value.
+    /// </summary>
+    /// <returns></returns>
+    void JSONPushParser::finishString()
+    {
+        std::string_view string = m_json.m_jsonTranslator->fromEscapeSequences(m_token);
+        if (m_stringIsKey)
+        {
+            m_handler->onKey(string);
+            m_state = State::colon;
+        }
+        else
+        {
+            m_handler->onString(string);
+            valueFinished();
+        }
+    }
+    /// <summary>
+    /// Check and convert a completed number.
+    /// </summary>
+    /// <returns></returns>
+    void JSONPushParser::finishNumber()
+    {
+        SpanSource source(m_token);
+        JNumeric numeric = m_json.extractNumber(source);
+        if (source.bytesToParse())
+        {
+            throw JSON::SyntaxError();
+        }
+        m_handler->onNumber(numeric, m_json.m_workBuffer);
+        valueFinished();
+    }
+    /// <summary>
+    /// Check a completed true, false or null.
+    /// </summary>
+    /// <returns></returns>
+    void JSONPushParser::finishLiteral()
+    {
+        if (m_token == "true")
+        {
+            m_handler->onBoolean(true);
+        }
+        else if (m_token == "false")
+        {
+            m_handler->onBoolean(false);
+        }
+        else if (m_token == "null")
+        {
+            m_handler->onNull();
+        }
+        else
+        {
+            throw JSON::SyntaxError();
+        }
+        valueFinished();
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// JSONPushParser constructor; a JNode structure is built.
+    /// </summary>
+    /// <param name="translator">Custom JSON string translator.</param>
+    JSONPushParser::JSONPushParser(JSON::ITranslator *translator)
+        : m_json(translator), m_builder(std::make_unique<JNodeBuilder>()), m_handler(m_builder.get())
+    {
+    }
+    /// <summary>
+    /// JSONPushParser constructor; events are raised on a handler.
+    /// </summary>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <param name="translator">Custom JSON string translator.</param>
+    JSONPushParser::JSONPushParser(JSON::IHandler &handler, JSON::ITranslator *translator)
+        : m_json(translator), m_handler(&handler)
+    {
+    }
+    /// <summary>
+    /// JSONPushParser destructor.
+    /// </summary>
+    JSONPushParser::~JSONPushParser()
+    {
+    }
+    /// <summary>
+    /// Parse the next chunk of JSON. Whitespace may follow the value but
+    /// anything else after it is a syntax error.
+    /// </summary>
+    /// <param name="chunk">Next chunk of JSON.</param>
+    /// <returns></returns>
+    void JSONPushParser::feed(std::string_view chunk)
+    {
+        std::size_t position = 0;
+        while (position < chunk.size())
+        {
+            char byte = chunk[position];
+            switch (m_state)
+            {
+            case State::string:
+            {
+                // Copy up to the closing quote in one go if it is in chunk
+                std::size_t end = position;
+                while ((end < chunk.size()) && (m_escaped || (chunk[end] != '"')))
+                {
+                    m_escaped = !m_escaped && (chunk[end] == '\\');
+                    end++;
+                }
+                m_token.append(chunk.data() + position, end - position);
+                position = end;
+                if (position < chunk.size())
+                {
+                    position++;
+                    finishString();
+                }
+                continue;
+            }
+            case State::number:
+                if (isNumberByte(byte))
+                {
+                    m_token += byte;
+                    position++;
+                }
+                else
+                {
+                    finishNumber();
+                }
+                continue;
+            case State::literal:
+                if (std::isalpha(byte))
+                {
+                    m_token += byte;
+                    position++;
+                }
+                else
+                {
+                    finishLiteral();
+                }
+                continue;
+            default:
+                break;
+            }
+            position++;
+            if (std::iswspace(byte))
+            {
+                continue;
+            }
+            switch (m_state)
+            {
+            case State::value:
+                startValue(byte);
+                break;
+            case State::nextEntry:
+                if (byte != '"')
+                {
+                    throw JSON::SyntaxError();
+                }
+                m_token.clear();
+                m_stringIsKey = true;
+                m_escaped = false;
+                m_state = State::string;
+                break;
+            case State::colon:
+                if (byte != ':')
+                {
+                    throw JSON::SyntaxError();
+                }
+                m_state = State::value;
+                break;
+            case State::afterValue:
+                if (byte == ',')
+                {
+                    m_state = (m_containers.back() == '{') ? State::nextEntry : State::value;
+                }
+                else
+                {
+                    closeContainer(byte);
+                }
+                break;
+            default:
+                throw JSON::SyntaxError();
+            }
+        }
+    }
+    /// <summary>
+    /// Mark the end of the JSON; it is a syntax error if the value is not
+    /// complete.
+    /// </summary>
+    /// <returns></returns>
+    void JSONPushParser::finish()
+    {
+        if (m_state == State::number)
+        {
+            finishNumber();
+        }
+        else if (m_state == State::literal)
+        {
+            finishLiteral();
+        }
+        if (m_state != State::finished)
+        {
+            throw JSON::SyntaxError();
+        }
+    }
+    /// <summary>
+    /// Has a complete JSON value been parsed.
+    /// </summary>
+    /// <returns>true if parsed value complete.</returns>
+    bool JSONPushParser::isComplete() const
+    {
+        return (m_state == State::finished);
+    }
+    /// <summary>
+    /// Take the JNode structure built for a complete value.
+    /// </summary>
+    /// <returns>JNode structure.</returns>
+    std::unique_ptr<JNode> JSONPushParser::getRoot()
+    {
+        if (m_builder == nullptr)
+        {
+            throw std::runtime_error("JSONPushParser raising events does not build JNodes.");
+        }
+        if (!isComplete())
+        {
+            throw std::runtime_error("JSONPushParser value is not complete.");
+        }
+        return (std::move(m_builder->m_root));
+    }
+    /// <summary>
+    /// Keep the original text of numbers in the JNodes built.
+    /// </summary>
+    /// <param name="keepNumberText">true if number text is to be kept.</param>
+    /// <returns></returns>
+    void JSONPushParser::keepNumberText(bool keepNumberText)
+    {
+        if (m_builder != nullptr)
+        {
+            m_builder->m_keepNumberText = keepNumberText;
+        }
+    }
+    /// <summary>
+    /// Pack arrays of numbers in the JNodes built (as JSON::packNumbers()).
+    /// </summary>
+    /// <param name="packNumbers">true if numeric arrays are to be packed.</param>
+    /// <returns></returns>
+    void JSONPushParser::packNumbers(bool packNumbers)
+    {
+        if (m_builder != nullptr)
+        {
+            m_builder->m_packNumbers = packNumbers;
+        }
+    }
+    /// <summary>
+    /// Set the maximum object/array nesting depth allowed.
+    /// </summary>
+    /// <param name="maxNestingDepth">Maximum nesting depth.</param>
+    /// <returns></returns>
+    void JSONPushParser::maxNestingDepth(std::size_t maxNestingDepth)
+    {
+        m_json.maxNestingDepth(maxNestingDepth);
+    }
+} // namespace H4
@@ -0,0 +1,323 @@
+//
+// Class: JSONReader
+//
+// Description: Pull reader for JSON. Calling next() reads the next token
+// (object/array start or end, key, string, number, boolean or null) and
+// makes its value available through views that stay valid until the
+// following call, so no JNodes are created. skipValue() jumps over a
+// whole object/array (or the value of a key) without translating strings
+// or converting numbers. The reader works over any JSON::ISource or
+// directly over a contiguous buffer; the token reading code is templated
+// on the source so a buffer is read without a virtual call per byte and
+// the JSON class extract methods are shared with the parser, as are its
+// grammar (so empty objects/arrays are not accepted) and nesting depth
+// limit.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSONReader.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Open an object/array, checking the nesting depth limit (as
+    /// JSON::parseBuffer() does).
+    /// </summary>
+    /// <param name="container">Object/array start token.</param>
+    /// <returns></returns>
+    void JSONReader::pushContainer(Token container)
+    {
+        if (m_containers.size() >= m_json.m_maxNestingDepth)
+        {
+            throw JSON::SyntaxError("Maximum nesting depth exceeded.");
+        }
+        m_containers.push_back(container);
+    }
+    /// <summary>
+    /// Translate a key or string value. A translation that is not just the
+    /// string passed in is a view of a buffer the translator reuses, so it
+    /// is copied into the reader's own work buffer to stop another reader
+    /// or parse on the same thread overwriting it.
+    /// </summary>
+    /// <param name="jsonString">String with escape sequences.</param>
+    /// <returns>Translated string (valid until the next token is read).</returns>
+    std::string_view JSONReader::translateString(std::string_view jsonString)
+    {
+        std::string_view translated = m_json.m_jsonTranslator->fromEscapeSequences(jsonString);
+        if (translated.data() == jsonString.data())
+        {
+            return (translated);
+        }
+        m_json.m_workBuffer.assign(translated);
+        return (m_json.m_workBuffer);
+    }
+    /// <summary>
+    /// Read an object key and the colon that follows it.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Key token.</returns>
+    template <typename T>
+    JSONReader::Token JSONReader::readKey(T &source)
+    {
+        m_json.ignoreWhiteSpace(source);
+        if (source.currentByte() != '"')
+        {
+            throw JSON::SyntaxError();
+        }
+        m_string = translateString(m_json.extractString(source));
+        m_json.ignoreWhiteSpace(source);
+        if (source.currentByte() != ':')
+        {
+            throw JSON::SyntaxError();
+        }
+        source.moveToNextByte();
+        m_state = State::value;
+        return (m_token = Token::key);
+    }
+    /// <summary>
+    /// Read a value; for an object or array just its start is read.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Value token.</returns>
+    template <typename T>
+    JSONReader::Token JSONReader::readValue(T &source)
+    {
+        m_json.ignoreWhiteSpace(source);
+        m_state = State::afterValue;
+        switch (source.currentByte())
+        {
+        case '"':
+            m_string = translateString(m_json.extractString(source));
+            return (m_token = Token::string);
+        case 't':
+        case 'f':
+            m_boolean = m_json.extractBoolean(source);
+            return (m_token = Token::boolean);
+        case 'n':
+            m_json.extractNull(source);
+            return (m_token = Token::null);
+        case '{':
+            pushContainer(Token::objectStart);
+            source.moveToNextByte();
+            m_state = State::key;
+            return (m_token = Token::objectStart);
+        case '[':
+            pushContainer(Token::arrayStart);
+            source.moveToNextByte();
+            m_state = State::value;
+            return (m_token = Token::arrayStart);
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+            m_numeric = m_json.extractNumber(source);
+            m_string = m_json.m_workBuffer;
+            return (m_token = Token::number);
+        }
+        throw JSON::SyntaxError();
+    }
+    /// <summary>
+    /// Read the next token from a source.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Token read.</returns>
+    template <typename T>
+    JSONReader::Token JSONReader::nextToken(T &source)
+    {
+        switch (m_state)
+        {
+        case State::value:
+            return (readValue(source));
+        case State::key:
+            return (readKey(source));
+        case State::afterValue:
+            if (m_containers.empty())
+            {
+                m_state = State::finished;
+                return (m_token = Token::end);
+            }
+            m_json.ignoreWhiteSpace(source);
+            if (source.currentByte() == ',')
+            {
+                source.moveToNextByte();
+                if (m_containers.back() == Token::objectStart)
+                {
+                    return (readKey(source));
+                }
+                return (readValue(source));
+            }
+            break;
+        case State::finished:
+            return (m_token = Token::end);
+        }
+        // Must be at the end of the current object/array
+        if ((m_containers.empty()) ||
+            ((m_containers.back() == Token::objectStart) && (source.currentByte() != '}')) ||
+            ((m_containers.back() == Token::arrayStart) && (source.currentByte() != ']')))
+        {
+            throw JSON::SyntaxError();
+        }
+        source.moveToNextByte();
+        m_token = (m_containers.back() == Token::objectStart) ? Token::objectEnd : Token::arrayEnd;
+        m_containers.pop_back();
+        m_state = State::afterValue;
+        return (m_token);
+    }
+    /// <summary>
+    /// Move past the end of the object/array whose start has just been
+    /// read. Only strings (so brackets inside them are ignored) and
+    /// bracket nesting are looked at; the contents are not validated.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSONReader::skipContainer(T &source)
+    {
+        int depth = 1;
+        while (source.bytesToParse())
+        {
+            switch (source.currentByte())
+            {
+            case '"':
+                source.moveToNextByte();
+                while (source.bytesToParse() && (source.currentByte() != '"'))
+                {
+                    if (source.currentByte() == '\\')
+                    {
+                        source.moveToNextByte();
+                        if (!source.bytesToParse())
+                        {
+                            break;
+                        }
+                    }
+                    source.moveToNextByte();
+                }
+                break;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0)
+                {
+                    source.moveToNextByte();
+                    m_token = (m_containers.back() == Token::objectStart) ? Token::objectEnd : Token::arrayEnd;
+                    m_containers.pop_back();
+                    m_state = State::afterValue;
+                    return;
+                }
+                break;
+            }
+            if (source.bytesToParse())
+            {
+                source.moveToNextByte();
+            }
+        }
+        throw JSON::SyntaxError();
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// JSONReader constructor for a contiguous buffer of JSON (which must
+    /// outlive the reader).
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer of JSON to be read.</param>
+    /// <param name="translator">Custom JSON string translator.</param>
+    JSONReader::JSONReader(std::string_view jsonBuffer, JSON::ITranslator *translator)
+        : m_json(translator), m_span(jsonBuffer)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+    }
+    /// <summary>
+    /// JSONReader constructor for a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="translator">Custom JSON string translator.</param>
+    JSONReader::JSONReader(JSON::ISource &source, JSON::ITranslator *translator)
+        : m_json(translator), m_span(std::string_view()), m_source(&source)
+    {
+    }
+    /// <summary>
+    /// Read the next token. Token::end is returned once the top level
+    /// value has been read (and from then on).
+    /// </summary>
+    /// <returns>Token read.</returns>
+    JSONReader::Token JSONReader::next()
+    {
+        return ((m_source != nullptr) ? nextToken(*m_source) : nextToken(m_span));
+    }
+    /// <summary>
+    /// Skip a value. If the current token is an object/array start the
+    /// rest of it is skipped (leaving the matching end as the current
+    /// token); if it is a key then its value is skipped. For any other
+    /// token there is nothing to do.
+    /// </summary>
+    /// <returns></returns>
+    void JSONReader::skipValue()
+    {
+        if (m_token == Token::key)
+        {
+            next();
+        }
+        if ((m_token == Token::objectStart) || (m_token == Token::arrayStart))
+        {
+            if (m_source != nullptr)
+            {
+                skipContainer(*m_source);
+            }
+            else
+            {
+                skipContainer(m_span);
+            }
+        }
+    }
+    /// <summary>
+    /// Set the maximum object/array nesting depth allowed.
+    /// </summary>
+    /// <param name="maxNestingDepth">Maximum nesting depth.</param>
+    /// <returns></returns>
+    void JSONReader::maxNestingDepth(std::size_t maxNestingDepth)
+    {
+        m_json.maxNestingDepth(maxNestingDepth);
+    }
+} // namespace H4
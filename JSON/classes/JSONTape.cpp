@@ -0,0 +1,298 @@
+//
+// Class: JSONTape
+//
+// Description: Freeze a JNode tree into a single contiguous tape of fixed
+// size entries plus a string arena (see JSONTape.hpp) that may be read
+// with JTapeValue, copied/persisted as plain bytes and loaded back. The
+// tree is flattened without recursion and a loaded tape is validated
+// before use so that a corrupt buffer cannot lead to reads off the tape.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSONTape.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <stdexcept>
+#include <climits>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    //
+    // Header at the start of a persisted tape buffer; followed by the
+    // entries and then the string arena.
+    //
+    struct TapeHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t entryCount;
+        std::uint64_t stringsSize;
+    };
+    static constexpr char kTapeMagic[4] = {'J', 'T', 'A', 'P'};
+    static constexpr std::uint32_t kTapeVersion = 1;
+    //
+    // Object/array being flattened or validated and how far through its
+    // children it has got.
+    //
+    struct TapeFrame
+    {
+        const JNode *jNode;
+        std::size_t entry;
+        std::size_t next;
+    };
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Append the entry for a JNode to the tape; the entry of an object/array
+    /// is completed once its children have been appended.
+    /// </summary>
+    /// <param name="jNode">JNode to append.</param>
+    /// <returns></returns>
+    void JSONTape::appendEntry(const JNode &jNode)
+    {
+        JTapeEntry entry{(std::uint8_t)jNode.nodeType, 0, 0, 0, 0};
+        switch (jNode.nodeType)
+        {
+        case JNodeType::object:
+            entry.size = (std::uint32_t)JNodeRef<JNodeObject>(jNode).size();
+            break;
+        case JNodeType::array:
+            entry.size = (std::uint32_t)JNodeRef<JNodeArray>(jNode).size();
+            break;
+        case JNodeType::number:
+            appendNumber(JNodeRef<JNodeNumber>(jNode).getNumeric());
+            return;
+        case JNodeType::string:
+            appendString(JNodeRef<JNodeString>(jNode).getString());
+            return;
+        case JNodeType::boolean:
+            entry.payload = JNodeRef<JNodeBoolean>(jNode).getBoolean() ? 1 : 0;
+            break;
+        case JNodeType::null:
+            break;
+        default:
+            throw std::runtime_error("Unknown JNode type encountered while freezing.");
+        }
+        m_entries.push_back(entry);
+    }
+    /// <summary>
+    /// Append a string (value or key) entry and copy its bytes to the
+    /// string arena.
+    /// </summary>
+    /// <param name="string">String to append.</param>
+    /// <returns></returns>
+    void JSONTape::appendString(std::string_view string)
+    {
+        if (string.size() > UINT32_MAX)
+        {
+            throw std::length_error("JSON string too large to be stored on a JSONTape.");
+        }
+        m_entries.push_back(JTapeEntry{(std::uint8_t)JNodeType::string, 0, 0, (std::uint32_t)string.size(), m_strings.size()});
+        m_strings.append(string);
+    }
+    /// <summary>
+    /// Append a number entry.
+    /// </summary>
+    /// <param name="numeric">Number to append.</param>
+    /// <returns></returns>
+    void JSONTape::appendNumber(const JNumeric &numeric)
+    {
+        JTapeEntry entry{(std::uint8_t)JNodeType::number, (std::uint8_t)numeric.kind, 0, 0, 0};
+        std::memcpy(&entry.payload, &numeric.integer, sizeof(entry.payload));
+        m_entries.push_back(entry);
+    }
+    /// <summary>
+    /// Check that the tape entries form exactly one well formed value whose
+    /// strings all lie within the arena and whose objects/arrays end where
+    /// their children do.
+    /// </summary>
+    /// <returns></returns>
+    void JSONTape::validate() const
+    {
+        // Open objects/arrays: entry and number of children still to come
+        std::vector<TapeFrame> frames;
+        std::size_t index = 0;
+        do
+        {
+            if (!frames.empty())
+            {
+                TapeFrame &frame = frames.back();
+                const JTapeEntry &container = m_entries[frame.entry];
+                if (frame.next == container.size)
+                {
+                    if (index != container.payload)
+                    {
+                        throw std::runtime_error("Invalid JSONTape.");
+                    }
+                    frames.pop_back();
+                    continue;
+                }
+                frame.next++;
+                if (container.type == JNodeType::object)
+                {
+                    if ((index >= container.payload) || (m_entries[index].type != JNodeType::string) || (m_entries[index].reserved != 0) ||
+                        (m_entries[index].payload > m_strings.size()) || (m_entries[index].size > m_strings.size() - m_entries[index].payload))
+                    {
+                        throw std::runtime_error("Invalid JSONTape.");
+                    }
+                    index++;
+                }
+            }
+            std::size_t end = frames.empty() ? m_entries.size() : (std::size_t)m_entries[frames.back().entry].payload;
+            if (index >= end)
+            {
+                throw std::runtime_error("Invalid JSONTape.");
+            }
+            const JTapeEntry &entry = m_entries[index];
+            bool container = (entry.type == JNodeType::object) || (entry.type == JNodeType::array);
+            if ((entry.reserved != 0) || (entry.type < JNodeType::object) || (entry.type > JNodeType::null) ||
+                ((entry.type == JNodeType::string) && ((entry.payload > m_strings.size()) || (entry.size > m_strings.size() - entry.payload))) ||
+                ((entry.type == JNodeType::number) && (entry.info > (std::uint8_t)JNumeric::Kind::floatingPoint)) ||
+                ((entry.type == JNodeType::boolean) && (entry.payload > 1)) ||
+                (container && ((entry.payload <= index) || (entry.payload > end) || (entry.size > INT_MAX))))
+            {
+                throw std::runtime_error("Invalid JSONTape.");
+            }
+            if (container)
+            {
+                frames.push_back(TapeFrame{nullptr, index, 0});
+            }
+            index++;
+        } while (!frames.empty());
+        if (index != m_entries.size())
+        {
+            throw std::runtime_error("Invalid JSONTape.");
+        }
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Freeze a JNode tree into a tape. Objects/arrays being flattened are
+    /// kept on an explicit stack so deep nesting does not use up the native
+    /// stack; any lazily parsed nodes are parsed as they are reached.
+    /// </summary>
+    /// <param name="jNodeRoot">Root of JNode tree.</param>
+    /// <returns>JSONTape holding the tree.</returns>
+    JSONTape JSONTape::freeze(const JNode &jNodeRoot)
+    {
+        JSONTape tape;
+        std::vector<TapeFrame> frames;
+        const JNode *jNode = &jNodeRoot;
+        while (true)
+        {
+            if (jNode == nullptr)
+            {
+                throw std::invalid_argument("Nullptr JNode encountered while freezing.");
+            }
+            tape.appendEntry(*jNode);
+            if ((jNode->nodeType == JNodeType::object) || (jNode->nodeType == JNodeType::array))
+            {
+                frames.push_back(TapeFrame{jNode, tape.m_entries.size() - 1, 0});
+            }
+            // Move on to the next child of the innermost unfinished object/array
+            bool moreChildren = false;
+            while (!frames.empty() && !moreChildren)
+            {
+                TapeFrame &frame = frames.back();
+                if (frame.next == tape.m_entries[frame.entry].size)
+                {
+                    tape.m_entries[frame.entry].payload = tape.m_entries.size();
+                    frames.pop_back();
+                }
+                else if (frame.jNode->nodeType == JNodeType::object)
+                {
+                    auto &entry = *(JNodeRef<JNodeObject>(*frame.jNode).getEntries().begin() + frame.next++);
+                    tape.appendString(entry.key);
+                    jNode = entry.value.get();
+                    moreChildren = true;
+                }
+                else if (JNodeRef<JNodeArray>(*frame.jNode).isPacked())
+                {
+                    // Packed numbers go straight on to the tape
+                    tape.appendNumber(JNodeRef<JNodeArray>(*frame.jNode).getPackedNumeric(frame.next++));
+                }
+                else
+                {
+                    jNode = JNodeRef<JNodeArray>(*frame.jNode).getArray()[frame.next++].get();
+                    moreChildren = true;
+                }
+            }
+            if (!moreChildren)
+            {
+                break;
+            }
+        }
+        // Tapes are long lived so drop any growth slack
+        tape.m_entries.shrink_to_fit();
+        tape.m_strings.shrink_to_fit();
+        return (tape);
+    }
+    /// <summary>
+    /// Load a tape saved with toBuffer(); the buffer is copied and checked
+    /// to hold a well formed tape.
+    /// </summary>
+    /// <param name="tapeBuffer">Buffer holding a saved tape.</param>
+    /// <returns>Loaded JSONTape.</returns>
+    JSONTape JSONTape::fromBuffer(std::string_view tapeBuffer)
+    {
+        TapeHeader header;
+        if (tapeBuffer.size() < sizeof(header))
+        {
+            throw std::runtime_error("Invalid JSONTape.");
+        }
+        std::memcpy(&header, tapeBuffer.data(), sizeof(header));
+        if ((std::memcmp(header.magic, kTapeMagic, sizeof(kTapeMagic)) != 0) || (header.version != kTapeVersion) ||
+            (header.entryCount > (tapeBuffer.size() - sizeof(header)) / sizeof(JTapeEntry)) ||
+            (header.stringsSize != tapeBuffer.size() - sizeof(header) - (header.entryCount * sizeof(JTapeEntry))))
+        {
+            throw std::runtime_error("Invalid JSONTape.");
+        }
+        JSONTape tape;
+        tape.m_entries.resize(header.entryCount);
+        std::memcpy(static_cast<void *>(tape.m_entries.data()), tapeBuffer.data() + sizeof(header), header.entryCount * sizeof(JTapeEntry));
+        tape.m_strings = tapeBuffer.substr(sizeof(header) + (header.entryCount * sizeof(JTapeEntry)));
+        tape.validate();
+        return (tape);
+    }
+    /// <summary>
+    /// Save a tape as bytes that fromBuffer() will load.
+    /// </summary>
+    /// <returns>Buffer holding the tape.</returns>
+    std::string JSONTape::toBuffer() const
+    {
+        TapeHeader header;
+        std::memcpy(header.magic, kTapeMagic, sizeof(kTapeMagic));
+        header.version = kTapeVersion;
+        header.entryCount = m_entries.size();
+        header.stringsSize = m_strings.size();
+        std::string tapeBuffer(sizeof(header) + (m_entries.size() * sizeof(JTapeEntry)) + m_strings.size(), '\0');
+        std::memcpy(tapeBuffer.data(), &header, sizeof(header));
+        std::memcpy(tapeBuffer.data() + sizeof(header), m_entries.data(), m_entries.size() * sizeof(JTapeEntry));
+        std::memcpy(tapeBuffer.data() + sizeof(header) + (m_entries.size() * sizeof(JTapeEntry)), m_strings.data(), m_strings.size());
+        return (tapeBuffer);
+    }
+} // namespace H4
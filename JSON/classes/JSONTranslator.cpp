@@ -4,6 +4,8 @@
 // Description: Translate to/from JSON string escapes within source
 // strings. This is the default translator but is possible to write 
 // a custom one and pass it to the JSON class constructor to be used.
+// Translated strings are built in per thread buffers so that one
+// translator may be used from any number of threads at once.
 //
 // Dependencies:   C20++ - Language standard features used.
 //
@@ -19,6 +21,13 @@
 //
 // C++ STL
 //
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 // =========
 // NAMESPACE
 // =========
@@ -33,6 +42,9 @@ namespace H4
     // ========================
     // PRIVATE STATIC VARIABLES
     // ========================
+    // Buffers that translated strings are returned in
+    static thread_local std::string unescapedBuffer;
+    static thread_local std::string escapedBuffer;
     // =======================
     // PUBLIC STATIC VARIABLES
     // =======================
@@ -40,134 +52,364 @@ namespace H4
     // PRIVATE METHODS
     // ===============
     /// <summary>
-    /// Initialise tables used to convert to/from single character
-    /// escape sequences within a JSON string.
+    /// Return a pointer to the first byte in a range that cannot be copied
+    /// to a JSON string as is (a control character, quote, backslash or
+    /// solidus and, unless raw UTF-8 is being written, any non-ASCII byte).
+    /// Sixteen bytes at a time are checked with SSE2 where it is available.
     /// </summary>
-    void JSONTranslator::initialiseTranslationMaps()
+    /// <param name="current">Start of range.</param>
+    /// <param name="end">End of range.</param>
+    /// <param name="rawUTF8">true then non-ASCII bytes need no escape.</param>
+    /// <returns>Pointer to byte needing an escape or end.</returns>
+    static const char *findEscape(const char *current, const char *end, bool rawUTF8)
     {
-        // From Escape sequence
-        m_fromMap['\\'] = u"\\";
-        m_fromMap['t'] = u"\t";
-        m_fromMap['\"'] = u"\"";
-        m_fromMap['/'] = u"/";
-        m_fromMap['b'] = u"\b";
-        m_fromMap['f'] = u"\f";
-        m_fromMap['n'] = u"\n";
-        m_fromMap['r'] = u"\r";
-        // To Escape sequence
-        m_toMap['\\'] = "\\\\";
-        m_toMap['\t'] = "\\t";
-        m_toMap['"'] = "\\\"";
-        m_toMap['/'] = "\\/";
-        m_toMap['\b'] = "\\b";
-        m_toMap['\f'] = "\\f";
-        m_toMap['\n'] = "\\n";
-        m_toMap['\r'] = "\\r";
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i solidus = _mm_set1_epi8('/');
+        const __m128i lastControl = _mm_set1_epi8(0x1F);
+        while (end - current >= 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(current));
+            __m128i escapes = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, quote), _mm_cmpeq_epi8(bytes, backslash)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(bytes, solidus), _mm_cmpeq_epi8(_mm_min_epu8(bytes, lastControl), bytes)));
+            unsigned mask = (unsigned)_mm_movemask_epi8(escapes);
+            if (!rawUTF8)
+            {
+                mask |= (unsigned)_mm_movemask_epi8(bytes);
+            }
+            if (mask != 0)
+            {
+#if defined(_MSC_VER)
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return (current + index);
+#else
+                return (current + __builtin_ctz(mask));
+#endif
+            }
+            current += 16;
+        }
+#endif
+        while (current != end)
+        {
+            unsigned char c = (unsigned char)*current;
+            if ((c < 0x20) || (c == '"') || (c == '\\') || (c == '/') || (!rawUTF8 && (c >= 0x80)))
+            {
+                break;
+            }
+            current++;
+        }
+        return (current);
+    }
+    /// <summary>
+    /// Append a "\uxxxx" escape for a UTF-16 code unit.
+    /// </summary>
+    /// <param name="utf16Char">UTF-16 code unit.</param>
+    /// <param name="jsonString">String to append to.</param>
+    static void appendUTF16Escape(char16_t utf16Char, std::string &jsonString)
+    {
+        static const char *digits = "0123456789ABCDEF";
+        char escape[6] = {'\\', 'u', digits[(utf16Char >> 12) & 0x0f], digits[(utf16Char >> 8) & 0x0f],
+                          digits[(utf16Char >> 4) & 0x0f], digits[utf16Char & 0x0f]};
+        jsonString.append(escape, sizeof(escape));
+    }
+    /// <summary>
+    /// Decode the four hex digits of a "\uxxxx" escape.
+    /// </summary>
+    /// <param name="hexDigits">Hex digits to decode.</param>
+    /// <returns>UTF-16 code unit.</returns>
+    char16_t JSONTranslator::decodeUTF16(std::string_view hexDigits)
+    {
+        if (hexDigits.size() < 4)
+        {
+            throw JSON::SyntaxError();
+        }
+        char16_t utf16Char = 0;
+        for (int digit = 0; digit < 4; digit++)
+        {
+            char hexDigit = hexDigits[digit];
+            utf16Char <<= 4;
+            if ((hexDigit >= '0') && (hexDigit <= '9'))
+            {
+                utf16Char |= hexDigit - '0';
+            }
+            else if ((hexDigit >= 'a') && (hexDigit <= 'f'))
+            {
+                utf16Char |= hexDigit - 'a' + 10;
+            }
+            else if ((hexDigit >= 'A') && (hexDigit <= 'F'))
+            {
+                utf16Char |= hexDigit - 'A' + 10;
+            }
+            else
+            {
+                throw JSON::SyntaxError();
+            }
+        }
+        return (utf16Char);
+    }
+    /// <summary>
+    /// Append a Unicode code point to a string encoded as UTF-8.
+    /// </summary>
+    /// <param name="codePoint">Code point to append.</param>
+    /// <param name="utf8String">String to append to.</param>
+    void JSONTranslator::appendUTF8(char32_t codePoint, std::string &utf8String)
+    {
+        if (codePoint < 0x80)
+        {
+            utf8String += (char)codePoint;
+        }
+        else if (codePoint < 0x800)
+        {
+            utf8String += (char)(0xC0 | (codePoint >> 6));
+            utf8String += (char)(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            utf8String += (char)(0xE0 | (codePoint >> 12));
+            utf8String += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            utf8String += (char)(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            utf8String += (char)(0xF0 | (codePoint >> 18));
+            utf8String += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+            utf8String += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            utf8String += (char)(0x80 | (codePoint & 0x3F));
+        }
     }
     // ==============
     // PUBLIC METHODS
     // ==============
     /// <summary>
     /// Convert any escape sequences in a string to their correct sequence
-    //  of UTF-8 characters. If input string contains any unpaired surrogates
-    //  then this is deemed as a syntax error and an error is duely thrown.
+    /// of UTF-8 characters. A string without escapes is returned as is;
+    /// otherwise it is decoded in one pass into a reusable per thread
+    /// buffer, so the result is only valid until the next call on the same
+    /// thread. If the input string
+    /// contains any unpaired surrogates then this is deemed as a syntax
+    /// error and an error is duely thrown.
     /// </summary>
     /// <param name="jsonString">JSON string to process.</param>
     /// <returns>String with escapes translated.</returns>
-    std::string JSONTranslator::fromEscapeSequences(const std::string &jsonString)
+    std::string_view JSONTranslator::fromEscapeSequences(std::string_view jsonString)
     {
-        m_utf16workBuffer.clear();
-        auto current = jsonString.begin();
-        while (current != jsonString.end())
+        std::size_t escape = jsonString.find('\\');
+        if (escape == std::string_view::npos)
         {
-            // Normal character
-            if (*current != '\\')
+            return (jsonString);
+        }
+        unescapedBuffer.clear();
+        std::size_t current = 0;
+        while (escape != std::string_view::npos)
+        {
+            // Characters up to escape
+            unescapedBuffer.append(jsonString.data() + current, escape - current);
+            current = escape + 1;
+            if (current == jsonString.size())
             {
-                m_utf16workBuffer += *current++;
+                throw JSON::SyntaxError();
             }
-            else
+            switch (jsonString[current++])
             {
-                // Escape sequence
-                current++;
-                if (current != jsonString.end())
+            case '\\':
+                unescapedBuffer += '\\';
+                break;
+            case '"':
+                unescapedBuffer += '"';
+                break;
+            case '/':
+                unescapedBuffer += '/';
+                break;
+            case 'b':
+                unescapedBuffer += '\b';
+                break;
+            case 'f':
+                unescapedBuffer += '\f';
+                break;
+            case 'n':
+                unescapedBuffer += '\n';
+                break;
+            case 'r':
+                unescapedBuffer += '\r';
+                break;
+            case 't':
+                unescapedBuffer += '\t';
+                break;
+            // UTF16 "\uxxxx"; surrogates must come as an upper/lower pair
+            case 'u':
+            {
+                char16_t utf16Char = decodeUTF16(jsonString.substr(current));
+                current += 4;
+                if (isValidSurrogateUpper(utf16Char))
                 {
-                    // Single character
-                    if (m_fromMap.count(*current) > 0)
+                    if ((jsonString.compare(current, 2, "\\u") != 0))
                     {
-                        m_utf16workBuffer += m_fromMap[*current++];
-                    }
-                    // UTF16 "\uxxxx" 
-                    else if ((*current == 'u') && ((current + 4) < jsonString.end()))
-                    {
-                        char hexDigits[5] = {current[1], current[2], current[3], current[4], '\0'};
-                        char *end;
-                        m_utf16workBuffer += std::strtol(hexDigits, &end, 16);
-                        if (*end != '\0')
-                        {
-                            throw JSON::SyntaxError();
-                        }
-                        current += 5; // Move paste the \uxxxx
+                        throw JSON::SyntaxError();
                     }
-                    else
+                    char16_t utf16Lower = decodeUTF16(jsonString.substr(current + 2));
+                    if (!isValidSurrogateLower(utf16Lower))
                     {
                         throw JSON::SyntaxError();
                     }
+                    current += 6;
+                    appendUTF8(0x10000 + (((char32_t)(utf16Char - 0xD800) << 10) | (char32_t)(utf16Lower - 0xDC00)), unescapedBuffer);
                 }
-                else
+                else if (isValidSurrogateLower(utf16Char))
                 {
                     throw JSON::SyntaxError();
                 }
+                else
+                {
+                    appendUTF8(utf16Char, unescapedBuffer);
+                }
+                break;
             }
+            default:
+                throw JSON::SyntaxError();
+            }
+            escape = jsonString.find('\\', current);
         }
-        // Check that there are no single unpaired UTF-16 surrogates.From wht I see this is
-        // meant to be an error but from searching the web I have not found a definitive answer.
-        int index = 0;
-        while (index <= ((int)m_utf16workBuffer.size() - 1))
+        unescapedBuffer.append(jsonString.data() + current, jsonString.size() - current);
+        return (unescapedBuffer);
+    }
+    /// <summary>
+    /// Decode the UTF-8 sequence starting at current into a code point,
+    /// moving current past it.
+    /// </summary>
+    /// <param name="current">Start of UTF-8 sequence.</param>
+    /// <param name="end">End of string.</param>
+    /// <returns>Code point.</returns>
+    char32_t JSONTranslator::decodeUTF8(const char *&current, const char *end)
+    {
+        unsigned char leadByte = (unsigned char)*current++;
+        int continuationBytes;
+        char32_t codePoint;
+        if (leadByte < 0x80)
         {
-            if (isValidSurrogateUpper(m_utf16workBuffer[index]) && isValidSurrogateLower(m_utf16workBuffer[index + 1]))
-            {
-                index++;
-            }
-            else if (isValidSurrogateUpper(m_utf16workBuffer[index]) || isValidSurrogateLower(m_utf16workBuffer[index + 1]))
+            return (leadByte);
+        }
+        else if ((leadByte & 0xE0) == 0xC0)
+        {
+            continuationBytes = 1;
+            codePoint = leadByte & 0x1F;
+        }
+        else if ((leadByte & 0xF0) == 0xE0)
+        {
+            continuationBytes = 2;
+            codePoint = leadByte & 0x0F;
+        }
+        else if ((leadByte & 0xF8) == 0xF0)
+        {
+            continuationBytes = 3;
+            codePoint = leadByte & 0x07;
+        }
+        else
+        {
+            throw std::invalid_argument("Invalid UTF-8 in string to be stringified.");
+        }
+        if (end - current < continuationBytes)
+        {
+            throw std::invalid_argument("Invalid UTF-8 in string to be stringified.");
+        }
+        for (int byte = 0; byte < continuationBytes; byte++)
+        {
+            if (((unsigned char)*current & 0xC0) != 0x80)
             {
-                throw JSON::SyntaxError();
+                throw std::invalid_argument("Invalid UTF-8 in string to be stringified.");
             }
-            index++;
+            codePoint = (codePoint << 6) | ((unsigned char)*current++ & 0x3F);
         }
-        return (m_utf8Toutf16.to_bytes(m_utf16workBuffer));
+        static const char32_t minimumCodePoint[] = {0, 0x80, 0x800, 0x10000};
+        if ((codePoint < minimumCodePoint[continuationBytes]) || (codePoint > 0x10FFFF) || ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)))
+        {
+            throw std::invalid_argument("Invalid UTF-8 in string to be stringified.");
+        }
+        return (codePoint);
     }
     /// <summary>
     /// Convert a string from raw charater values (UTF8) so that it has character
-    /// escapes where applicable for its JSON form.
+    /// escapes where applicable for its JSON form. Only control characters,
+    /// quotes, backslashes and solidus (so that "\/" round trips) are
+    /// escaped, plus non-ASCII characters as "\uxxxx" unless the translator
+    /// writes raw UTF-8. Runs of characters in between are found with SIMD
+    /// where available and copied in one go.
+    /// A string that needs no escapes is returned as is, otherwise the result
+    /// is in a reusable per thread buffer and only valid until the next call
+    /// on the same thread.
     /// </summary>
     /// <param name="utf8String">String to convert.</param>
     /// <returns>JSON string with escapes.</returns>
-    std::string JSONTranslator::toEscapeSequences(std::string const &utf8String)
+    std::string_view JSONTranslator::toEscapeSequences(std::string_view utf8String)
     {
-        m_utf8workBuffer.clear();
-        for (char16_t utf16char : m_utf8Toutf16.from_bytes(utf8String))
+        const char *current = utf8String.data();
+        const char *end = utf8String.data() + utf8String.size();
+        const char *escape = findEscape(current, end, m_rawUTF8);
+        if (escape == end)
+        {
+            return (utf8String);
+        }
+        escapedBuffer.clear();
+        escapedBuffer.reserve(utf8String.size() + 16);
+        while (escape != end)
         {
-            // Control characters
-            if (m_toMap.count(utf16char) > 0)
+            escapedBuffer.append(current, escape - current);
+            current = escape;
+            switch (*current)
             {
-                m_utf8workBuffer += m_toMap[utf16char];
-            }
-            // ASCII
-            else if ((utf16char > 0x1F) && (utf16char < 0x80))
+            case '"':
+                escapedBuffer += "\\\"";
+                current++;
+                break;
+            case '\\':
+                escapedBuffer += "\\\\";
+                current++;
+                break;
+            case '/':
+                escapedBuffer += "\\/";
+                current++;
+                break;
+            case '\b':
+                escapedBuffer += "\\b";
+                current++;
+                break;
+            case '\f':
+                escapedBuffer += "\\f";
+                current++;
+                break;
+            case '\n':
+                escapedBuffer += "\\n";
+                current++;
+                break;
+            case '\r':
+                escapedBuffer += "\\r";
+                current++;
+                break;
+            case '\t':
+                escapedBuffer += "\\t";
+                current++;
+                break;
+            default:
             {
-                m_utf8workBuffer += (char)utf16char;
+                // Other control characters and (escaped) non-ASCII
+                char32_t codePoint = decodeUTF8(current, end);
+                if (codePoint >= 0x10000)
+                {
+                    codePoint -= 0x10000;
+                    appendUTF16Escape((char16_t)(0xD800 + (codePoint >> 10)), escapedBuffer);
+                    appendUTF16Escape((char16_t)(0xDC00 + (codePoint & 0x3FF)), escapedBuffer);
+                }
+                else
+                {
+                    appendUTF16Escape((char16_t)codePoint, escapedBuffer);
+                }
+                break;
             }
-            // UTF8 escaped
-            else
-            {
-                static const char *digits = "0123456789ABCDEF";
-                m_utf8workBuffer += "\\u";
-                m_utf8workBuffer += digits[(utf16char >> 12) & 0x0f];
-                m_utf8workBuffer += digits[(utf16char >> 8) & 0x0f];
-                m_utf8workBuffer += digits[(utf16char >> 4) & 0x0f];
-                m_utf8workBuffer += digits[(utf16char)&0x0f];
             }
+            escape = findEscape(current, end, m_rawUTF8);
         }
-        return (m_utf8workBuffer);
-    };
+        escapedBuffer.append(current, end - current);
+        return (escapedBuffer);
+    }
 } // namespace H4
@@ -0,0 +1,443 @@
+//
+// Class: JSON
+//
+// Description: Columnar extraction of fields from an array of objects
+// (records). Each requested field is filled into a typed JSONColumn with a
+// row per record in one pass, either from a parsed JNode array or straight
+// from JSON in a buffer/file using parse events so that no JNode tree is
+// built. Both can split the records into runs that are extracted
+// concurrently, the columns of each run then being joined in order.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <thread>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    // Records per run below which extracting from a tree is not split
+    static constexpr std::size_t kMinParallelRecords = 1024;
+    //
+    // Parse event handler that adds a row to each column for every top
+    // level element of a run of array elements; anything nested below the
+    // fields of a record is skipped. The values of a record are held until
+    // it ends so that, as for a JNodeObject, the last of any duplicate keys
+    // is the one used.
+    //
+    class ColumnHandler : public JSON::IHandler
+    {
+    public:
+        explicit ColumnHandler(std::vector<JSONColumn> &columns) : m_columns(columns), m_values(columns.size())
+        {
+        }
+        void onObjectStart() override
+        {
+            startValue(Value::State::null);
+        }
+        void onObjectEnd() override
+        {
+            endContainer();
+        }
+        void onArrayStart() override
+        {
+            startValue(Value::State::null);
+        }
+        void onArrayEnd() override
+        {
+            endContainer();
+        }
+        void onKey(std::string_view key) override
+        {
+            if (m_depth == 1)
+            {
+                m_field = kNoField;
+                for (std::size_t column = 0; column < m_columns.size(); column++)
+                {
+                    if (m_columns[column].name == key)
+                    {
+                        m_field = column;
+                        break;
+                    }
+                }
+            }
+        }
+        void onString(std::string_view string) override
+        {
+            if (Value *value = fieldValue())
+            {
+                value->state = Value::State::string;
+                value->string.assign(string);
+            }
+            endScalar();
+        }
+        void onNumber(const JNumeric &numeric, std::string_view /*text*/) override
+        {
+            if (Value *value = fieldValue())
+            {
+                value->state = Value::State::number;
+                value->numeric = numeric;
+            }
+            endScalar();
+        }
+        void onBoolean(bool /*boolean*/) override
+        {
+            if (Value *value = fieldValue())
+            {
+                value->state = Value::State::null;
+            }
+            endScalar();
+        }
+        void onNull() override
+        {
+            if (Value *value = fieldValue())
+            {
+                value->state = Value::State::null;
+            }
+            endScalar();
+        }
+
+    private:
+        static constexpr std::size_t kNoField = (std::size_t)-1;
+        //
+        // Value of a field in the current record.
+        //
+        struct Value
+        {
+            enum class State : std::uint8_t
+            {
+                none,
+                null,
+                number,
+                string
+            };
+            State state = State::none;
+            JNumeric numeric;
+            std::string string;
+        };
+        // Value for the field of the current key (if it is one being extracted)
+        Value *fieldValue()
+        {
+            return (((m_depth == 1) && (m_field != kNoField)) ? &m_values[m_field] : nullptr);
+        }
+        void startValue(Value::State state)
+        {
+            if (Value *value = fieldValue())
+            {
+                value->state = state;
+            }
+            m_field = kNoField;
+            m_depth++;
+        }
+        void endContainer()
+        {
+            if (--m_depth == 0)
+            {
+                endRecord();
+            }
+        }
+        // A top level element that is not an object/array is a record of nulls
+        void endScalar()
+        {
+            m_field = kNoField;
+            if (m_depth == 0)
+            {
+                endRecord();
+            }
+        }
+        void endRecord()
+        {
+            for (std::size_t column = 0; column < m_columns.size(); column++)
+            {
+                Value &value = m_values[column];
+                switch (value.state)
+                {
+                case Value::State::number:
+                    m_columns[column].appendNumber(value.numeric);
+                    break;
+                case Value::State::string:
+                    m_columns[column].appendString(value.string);
+                    break;
+                default:
+                    m_columns[column].appendNull();
+                    break;
+                }
+                value.state = Value::State::none;
+            }
+        }
+        std::vector<JSONColumn> &m_columns;
+        std::vector<Value> m_values;
+        std::size_t m_field = kNoField;
+        std::size_t m_depth = 0;
+    };
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Create empty columns for a list of fields.
+    /// </summary>
+    /// <param name="fields">Fields to extract.</param>
+    /// <returns>Empty columns.</returns>
+    static std::vector<JSONColumn> makeColumns(const std::vector<JSONColumn::Field> &fields)
+    {
+        if (fields.empty())
+        {
+            throw std::invalid_argument("No fields passed to be extracted.");
+        }
+        return (std::vector<JSONColumn>(fields.begin(), fields.end()));
+    }
+    /// <summary>
+    /// Run an extraction for each run on its own thread (the caller's if
+    /// there is only one) and join the columns of the runs in order.
+    /// </summary>
+    /// <param name="fields">Fields to extract.</param>
+    /// <param name="runCount">Number of runs.</param>
+    /// <param name="extractRun">Extract the rows of a run into columns.</param>
+    /// <returns>Joined columns.</returns>
+    static std::vector<JSONColumn> extractRuns(const std::vector<JSONColumn::Field> &fields, std::size_t runCount,
+                                               const std::function<void(std::size_t, std::vector<JSONColumn> &)> &extractRun)
+    {
+        std::vector<JSONColumn> columns = makeColumns(fields);
+        if (runCount == 1)
+        {
+            extractRun(0, columns);
+            return (columns);
+        }
+        std::vector<std::vector<JSONColumn>> runColumns(runCount, columns);
+        std::vector<std::exception_ptr> runErrors(runCount);
+        std::vector<std::thread> workers;
+        try
+        {
+            for (std::size_t run = 0; run < runCount; run++)
+            {
+                workers.emplace_back([&, run]()
+                                     {
+                                         try
+                                         {
+                                             extractRun(run, runColumns[run]);
+                                         }
+                                         catch (...)
+                                         {
+                                             runErrors[run] = std::current_exception();
+                                         } });
+            }
+        }
+        catch (...)
+        {
+            // Threads already started are joined before the failure to start
+            // another is passed on
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            throw;
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (auto &runError : runErrors)
+        {
+            if (runError != nullptr)
+            {
+                std::rethrow_exception(runError);
+            }
+        }
+        for (auto &run : runColumns)
+        {
+            for (std::size_t column = 0; column < columns.size(); column++)
+            {
+                columns[column].appendColumn(run[column]);
+            }
+        }
+        return (columns);
+    }
+    /// <summary>
+    /// Add a row to each column for a record JNode.
+    /// </summary>
+    /// <param name="record">Record (any non-object being a row of nulls).</param>
+    /// <param name="columns">Columns to add to.</param>
+    /// <returns></returns>
+    static void extractRecord(const JNode &record, std::vector<JSONColumn> &columns)
+    {
+        for (auto &column : columns)
+        {
+            const JNode *value = (record.nodeType == JNodeType::object) ? JNodeRef<JNodeObject>(record).getEntry(column.name) : nullptr;
+            if (value == nullptr)
+            {
+                column.appendNull();
+            }
+            else if (value->nodeType == JNodeType::number)
+            {
+                column.appendNumber(JNodeRef<JNodeNumber>(*value).getNumeric());
+            }
+            else if (value->nodeType == JNodeType::string)
+            {
+                column.appendString(JNodeRef<JNodeString>(*value).getString());
+            }
+            else
+            {
+                column.appendNull();
+            }
+        }
+    }
+    /// <summary>
+    /// Parse a run of comma separated array elements raising events for
+    /// each on a handler.
+    /// </summary>
+    /// <param name="source">Indexed source for run of elements.</param>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <returns></returns>
+    void JSON::parseElementEvents(IndexedSource &source, IHandler &handler)
+    {
+        for (;;)
+        {
+            source.skipWhiteSpace();
+            parseEvents(source, handler);
+            source.skipWhiteSpace();
+            if (!source.bytesToParse())
+            {
+                return;
+            }
+            if (source.currentByte() != ',')
+            {
+                throw JSON::SyntaxError();
+            }
+            source.moveToNextByte();
+        }
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Extract fields from each record of a JNode array into typed columns.
+    /// With more than one thread the records are split into runs extracted
+    /// concurrently; any lazily parsed records are parsed first so that each
+    /// record is only ever read by the one thread.
+    /// </summary>
+    /// <param name="jNodeArray">Array of records.</param>
+    /// <param name="fields">Fields to extract.</param>
+    /// <param name="threadCount">Number of threads to use (0 for one per core).</param>
+    /// <returns>Column per field.</returns>
+    std::vector<JSONColumn> JSON::extractColumns(const JNode &jNodeArray, const std::vector<JSONColumn::Field> &fields, unsigned threadCount)
+    {
+        if (jNodeArray.nodeType != JNodeType::array)
+        {
+            throw std::invalid_argument("JNode passed to have columns extracted is not an array.");
+        }
+        if (threadCount == 0)
+        {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        if (JNodeRef<JNodeArray>(jNodeArray).isPacked())
+        {
+            // Packed numbers are records that are not objects
+            return (extractRuns(fields, 1, [&](std::size_t, std::vector<JSONColumn> &columns)
+                                {
+                                    for (std::size_t record = 0; record < JNodeRef<JNodeArray>(jNodeArray).packedSize(); record++)
+                                    {
+                                        for (auto &column : columns)
+                                        {
+                                            column.appendNull();
+                                        }
+                                    } }));
+        }
+        const auto &records = JNodeRef<JNodeArray>(jNodeArray).getArray();
+        std::size_t runCount = std::max(std::min<std::size_t>(threadCount, records.size() / kMinParallelRecords), std::size_t(1));
+        if (runCount > 1)
+        {
+            for (auto &record : records)
+            {
+                if (record->nodeType == JNodeType::object)
+                {
+                    JNodeRef<JNodeObject>(*record).size();
+                }
+            }
+        }
+        return (extractRuns(fields, runCount, [&](std::size_t run, std::vector<JSONColumn> &columns)
+                            {
+                                for (std::size_t record = records.size() * run / runCount; record < records.size() * (run + 1) / runCount; record++)
+                                {
+                                    extractRecord(*records[record], columns);
+                                } }));
+    }
+    /// <summary>
+    /// Extract fields from each record of the top level array of JSON in a
+    /// buffer into typed columns without building any JNodes. With more than
+    /// one thread the records are split into runs of about the same size
+    /// that are parsed concurrently (unless the buffer is too large to be
+    /// indexed).
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer contains JSON array of records.</param>
+    /// <param name="fields">Fields to extract.</param>
+    /// <param name="threadCount">Number of threads to use (0 for one per core).</param>
+    /// <returns>Column per field.</returns>
+    std::vector<JSONColumn> JSON::extractColumnsFromBuffer(std::string_view jsonBuffer, const std::vector<JSONColumn::Field> &fields, unsigned threadCount)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        if (threadCount == 0)
+        {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        std::vector<std::uint32_t> index;
+        if (jsonBuffer.size() < IndexedSource::kMaxIndexedSize)
+        {
+            buildStructuralIndex(jsonBuffer, index);
+        }
+        std::vector<std::string_view> runs = splitArrayIntoRuns(jsonBuffer, index, threadCount);
+        return (extractRuns(fields, runs.size(), [&](std::size_t run, std::vector<JSONColumn> &columns)
+                            {
+                                ColumnHandler handler(columns);
+                                IndexedSource source = index.empty() ? IndexedSource(runs[run]) : IndexedSource(runs[run], jsonBuffer.data(), index);
+                                WorkScope(*this).json.parseElementEvents(source, handler); }));
+    }
+    /// <summary>
+    /// Extract fields from each record of the top level array of JSON in a
+    /// file into typed columns without building any JNodes. The file is
+    /// memory mapped (or read in whole).
+    /// </summary>
+    /// <param name="sourceFileName">JSON source file name</param>
+    /// <param name="fields">Fields to extract.</param>
+    /// <param name="threadCount">Number of threads to use (0 for one per core).</param>
+    /// <returns>Column per field.</returns>
+    std::vector<JSONColumn> JSON::extractColumnsFromFile(const std::string &sourceFileName, const std::vector<JSONColumn::Field> &fields, unsigned threadCount)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource file(sourceFileName);
+        return (extractColumnsFromBuffer(file.remainingBytes(), fields, threadCount));
+    }
+} // namespace H4
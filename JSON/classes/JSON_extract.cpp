@@ -0,0 +1,466 @@
+//
+// Class: JSON
+//
+// Description: Extraction of values addressed by JSON Pointers (RFC 6901)
+// without parsing the whole of the JSON. The source is walked once for a
+// batch of pointers; object entries and array elements that no pointer
+// passes through are parsed without creating anything (so are still
+// validated) and JNodes are only created for the values pointed to. As for a JNodeObject the last of
+// any duplicate keys is the one used, so an object that a pointer passes
+// through is always walked to its end; the walk stops as soon as every
+// pointer has been resolved and only arrays enclose the current position
+// (so the rest of the source is neither read nor validated). Pointers that
+// address nothing return nullptr.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <charconv>
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Split a JSON Pointer into its reference tokens, replacing "~1" with
+    /// "/" and "~0" with "~" in each.
+    /// </summary>
+    /// <param name="pointer">JSON Pointer.</param>
+    /// <param name="result">Index of result for pointer.</param>
+    /// <returns>Parsed pointer.</returns>
+    JSON::JSONPointer JSON::parsePointer(std::string_view pointer, std::size_t result)
+    {
+        JSONPointer jsonPointer{{}, result, false};
+        if (pointer.empty())
+        {
+            return (jsonPointer);
+        }
+        if (pointer[0] != '/')
+        {
+            throw std::invalid_argument("JSON Pointer must be empty or start with a '/'.");
+        }
+        for (std::size_t index = 0; index < pointer.size(); index++)
+        {
+            if (pointer[index] == '/')
+            {
+                jsonPointer.referenceTokens.emplace_back();
+            }
+            else if (pointer[index] == '~')
+            {
+                if ((index + 1 < pointer.size()) && ((pointer[index + 1] == '0') || (pointer[index + 1] == '1')))
+                {
+                    jsonPointer.referenceTokens.back() += (pointer[++index] == '0') ? '~' : '/';
+                }
+                else
+                {
+                    throw std::invalid_argument("JSON Pointer contains an invalid '~' escape.");
+                }
+            }
+            else
+            {
+                jsonPointer.referenceTokens.back() += pointer[index];
+            }
+        }
+        return (jsonPointer);
+    }
+    /// <summary>
+    /// Copy a JNode structure; the copy is made from an explicit stack of
+    /// the objects/arrays being copied so deep nesting does not use up the
+    /// native stack. Packed numeric arrays are copied packed.
+    /// </summary>
+    /// <param name="jNode">JNode structure to copy.</param>
+    /// <returns>Copy of JNode structure.</returns>
+    static std::unique_ptr<JNode> cloneJNode(const JNode &jNode)
+    {
+        // Copy of a single node (objects/arrays without their entries)
+        auto copyNode = [](const JNode &from) -> std::unique_ptr<JNode>
+        {
+            switch (from.nodeType)
+            {
+            case JNodeType::object:
+                return (std::make_unique<JNodeObject>());
+            case JNodeType::array:
+                return (std::make_unique<JNodeArray>());
+            case JNodeType::number:
+                return (std::make_unique<JNodeNumber>(JNodeRef<JNodeNumber>(from).getNumeric(), JNodeRef<JNodeNumber>(from).getText()));
+            case JNodeType::string:
+                return (std::make_unique<JNodeString>(JNodeRef<JNodeString>(from).getString()));
+            case JNodeType::boolean:
+                return (std::make_unique<JNodeBoolean>(JNodeRef<JNodeBoolean>(from).getBoolean()));
+            case JNodeType::null:
+                return (std::make_unique<JNodeNull>());
+            default:
+                throw std::runtime_error("Unknown JNode type encountered while copying.");
+            }
+        };
+        //
+        // Object/array being copied and its next entry.
+        //
+        struct CloneFrame
+        {
+            const JNode *from;
+            JNode *to;
+            std::size_t next;
+        };
+        std::unique_ptr<JNode> jNodeRoot = copyNode(jNode);
+        std::vector<CloneFrame> frames;
+        if ((jNode.nodeType == JNodeType::object) || (jNode.nodeType == JNodeType::array))
+        {
+            frames.push_back(CloneFrame{&jNode, jNodeRoot.get(), 0});
+        }
+        while (!frames.empty())
+        {
+            CloneFrame &frame = frames.back();
+            if (frame.from->nodeType == JNodeType::object)
+            {
+                const auto &entries = JNodeRef<JNodeObject>(*frame.from).getEntries();
+                if (frame.next == entries.size())
+                {
+                    frames.pop_back();
+                    continue;
+                }
+                auto &entry = *(entries.begin() + frame.next++);
+                const JNode *from = entry.value.get();
+                std::unique_ptr<JNode> to = (from != nullptr) ? copyNode(*from) : nullptr;
+                JNode *child = to.get();
+                JNodeRef<JNodeObject>(*frame.to).addEntry(entry.key, std::move(to));
+                if ((child != nullptr) && ((from->nodeType == JNodeType::object) || (from->nodeType == JNodeType::array)))
+                {
+                    frames.push_back(CloneFrame{from, child, 0});
+                }
+            }
+            else if (JNodeRef<JNodeArray>(*frame.from).isPacked())
+            {
+                const JNodeArray &packed = JNodeRef<JNodeArray>(*frame.from);
+                for (std::size_t index = 0; index < (std::size_t)packed.size(); index++)
+                {
+                    JNodeRef<JNodeArray>(*frame.to).packNumber(packed.getPackedNumeric(index));
+                }
+                frames.pop_back();
+            }
+            else
+            {
+                const auto &elements = JNodeRef<JNodeArray>(*frame.from).getArray();
+                if (frame.next == elements.size())
+                {
+                    frames.pop_back();
+                    continue;
+                }
+                const JNode *from = elements[frame.next++].get();
+                std::unique_ptr<JNode> to = (from != nullptr) ? copyNode(*from) : nullptr;
+                JNode *child = to.get();
+                JNodeRef<JNodeArray>(*frame.to).addEntry(std::move(to));
+                if ((child != nullptr) && ((from->nodeType == JNodeType::object) || (from->nodeType == JNodeType::array)))
+                {
+                    frames.push_back(CloneFrame{from, child, 0});
+                }
+            }
+        }
+        return (jNodeRoot);
+    }
+    /// <summary>
+    /// Mark pointers as resolved (a duplicate object key can lead to the
+    /// same pointer matching twice).
+    /// </summary>
+    /// <param name="pointers">Pointers resolved.</param>
+    /// <param name="remaining">Number of pointers not yet resolved.</param>
+    /// <returns></returns>
+    void JSON::resolvePointers(const std::vector<const JSONPointer *> &pointers, std::size_t &remaining)
+    {
+        for (auto pointer : pointers)
+        {
+            if (!pointer->resolved)
+            {
+                pointer->resolved = true;
+                remaining--;
+            }
+        }
+    }
+    /// <summary>
+    /// Move past a value in a JSON source stream without creating anything
+    /// for it. It is parsed with a handler that ignores every event so that
+    /// its syntax (and nesting depth) is checked as for any other parse.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::skipValue(T &source)
+    {
+        IHandler handler;
+        parseEvents(source, handler);
+    }
+    /// <summary>
+    /// Return a copy of the value a pointer addresses within a value that
+    /// has already been parsed for another pointer (nullptr if there is no
+    /// such value).
+    /// </summary>
+    /// <param name="jNode">Parsed value.</param>
+    /// <param name="pointer">JSON Pointer.</param>
+    /// <param name="depth">Number of reference tokens already resolved.</param>
+    /// <returns>Copy of addressed value.</returns>
+    std::unique_ptr<JNode> JSON::copyMatched(JNode *jNode, const JSONPointer &pointer, std::size_t depth)
+    {
+        for (; (jNode != nullptr) && (depth < pointer.referenceTokens.size()); depth++)
+        {
+            const std::string &referenceToken = pointer.referenceTokens[depth];
+            if (jNode->nodeType == JNodeType::object)
+            {
+                jNode = JNodeRef<JNodeObject>(*jNode).getEntry(referenceToken);
+            }
+            else if (jNode->nodeType == JNodeType::array)
+            {
+                int index = -1;
+                std::from_chars(referenceToken.data(), referenceToken.data() + referenceToken.size(), index);
+                if ((index < 0) || (index >= JNodeRef<JNodeArray>(*jNode).size()) || (std::to_string(index) != referenceToken))
+                {
+                    return (nullptr);
+                }
+                jNode = JNodeRef<JNodeArray>(*jNode).getEntry(index);
+            }
+            else
+            {
+                return (nullptr);
+            }
+        }
+        if (jNode == nullptr)
+        {
+            return (nullptr);
+        }
+        return (cloneJNode(*jNode));
+    }
+    /// <summary>
+    /// Walk the value at the current position of a JSON source stream for
+    /// the pointers whose reference tokens have matched so far; a pointer
+    /// with no tokens left addresses this value which is then parsed.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="pointers">Pointers matched up to this value.</param>
+    /// <param name="depth">Number of reference tokens matched.</param>
+    /// <param name="results">Values addressed by pointers.</param>
+    /// <param name="remaining">Number of pointers not yet resolved.</param>
+    /// <param name="stopWhenResolved">true if only arrays enclose the value so the walk may stop once all pointers are resolved.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::extractPointers(T &source, const std::vector<const JSONPointer *> &pointers, std::size_t depth,
+                               std::vector<std::unique_ptr<JNode>> &results, std::size_t &remaining, bool stopWhenResolved)
+    {
+        if (pointers.empty())
+        {
+            skipValue(source);
+            return;
+        }
+        // Any pointer ending here means the whole value is parsed; deeper
+        // pointers are resolved against (a copy of) what it parsed to.
+        const JSONPointer *matched = nullptr;
+        for (auto pointer : pointers)
+        {
+            if (pointer->referenceTokens.size() == depth)
+            {
+                matched = pointer;
+                break;
+            }
+        }
+        if (matched != nullptr)
+        {
+            std::unique_ptr<JNode> jNode = parseJNodes(source);
+            for (auto pointer : pointers)
+            {
+                if (pointer != matched)
+                {
+                    results[pointer->result] = copyMatched(jNode.get(), *pointer, depth);
+                }
+            }
+            results[matched->result] = std::move(jNode);
+            resolvePointers(pointers, remaining);
+            return;
+        }
+        std::vector<const JSONPointer *> entryPointers;
+        if (source.currentByte() == '{')
+        {
+            do
+            {
+                source.moveToNextByte();
+                ignoreWhiteSpace(source);
+                if (source.currentByte() != '"')
+                {
+                    throw JSON::SyntaxError();
+                }
+                std::string_view key = m_jsonTranslator->fromEscapeSequences(extractString(source));
+                entryPointers.clear();
+                for (auto pointer : pointers)
+                {
+                    if (pointer->referenceTokens[depth] == key)
+                    {
+                        entryPointers.push_back(pointer);
+                    }
+                }
+                ignoreWhiteSpace(source);
+                if (source.currentByte() != ':')
+                {
+                    throw JSON::SyntaxError();
+                }
+                source.moveToNextByte();
+                ignoreWhiteSpace(source);
+                // A duplicate key replaces what was found for an earlier one
+                for (auto pointer : entryPointers)
+                {
+                    results[pointer->result].reset();
+                }
+                extractPointers(source, entryPointers, depth + 1, results, remaining, false);
+                ignoreWhiteSpace(source);
+            } while (source.currentByte() == ',');
+            if (source.currentByte() != '}')
+            {
+                throw JSON::SyntaxError();
+            }
+            source.moveToNextByte();
+        }
+        else if (source.currentByte() == '[')
+        {
+            char indexBuffer[JNumeric::kMaxTextLength];
+            std::size_t index = 0;
+            do
+            {
+                source.moveToNextByte();
+                ignoreWhiteSpace(source);
+                std::string_view indexText(indexBuffer, std::to_chars(indexBuffer, indexBuffer + sizeof(indexBuffer), index++).ptr - indexBuffer);
+                entryPointers.clear();
+                for (auto pointer : pointers)
+                {
+                    if (pointer->referenceTokens[depth] == indexText)
+                    {
+                        entryPointers.push_back(pointer);
+                    }
+                }
+                extractPointers(source, entryPointers, depth + 1, results, remaining, stopWhenResolved);
+                if (stopWhenResolved && (remaining == 0))
+                {
+                    return;
+                }
+                ignoreWhiteSpace(source);
+            } while (source.currentByte() == ',');
+            if (source.currentByte() != ']')
+            {
+                throw JSON::SyntaxError();
+            }
+            source.moveToNextByte();
+        }
+        else
+        {
+            // Pointers go past a scalar so address nothing
+            skipValue(source);
+            resolvePointers(pointers, remaining);
+        }
+    }
+    /// <summary>
+    /// Extract the values for a batch of JSON Pointers from a JSON source
+    /// stream in one pass.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="pointers">JSON Pointers.</param>
+    /// <returns>Values addressed by pointers (nullptr for none).</returns>
+    template <typename T>
+    std::vector<std::unique_ptr<JNode>> JSON::extractAll(T &source, const std::vector<std::string> &pointers)
+    {
+        std::vector<JSONPointer> jsonPointers;
+        std::vector<const JSONPointer *> active;
+        jsonPointers.reserve(pointers.size());
+        for (auto &pointer : pointers)
+        {
+            jsonPointers.push_back(parsePointer(pointer, jsonPointers.size()));
+        }
+        for (auto &jsonPointer : jsonPointers)
+        {
+            active.push_back(&jsonPointer);
+        }
+        std::vector<std::unique_ptr<JNode>> results(pointers.size());
+        std::size_t remaining = active.size();
+        ignoreWhiteSpace(source);
+        extractPointers(source, active, 0, results, remaining, true);
+        return (results);
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Extract the value addressed by a JSON Pointer from a JSON source.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="pointer">JSON Pointer (eg. "/a/b/3/c").</param>
+    /// <returns>Value addressed by pointer (nullptr for none).</returns>
+    std::unique_ptr<JNode> JSON::extract(ISource &source, std::string_view pointer)
+    {
+        return (std::move(WorkScope(*this).json.extractAll(source, std::vector<std::string>{std::string(pointer)})[0]));
+    }
+    /// <summary>
+    /// Extract the values addressed by a batch of JSON Pointers from a
+    /// JSON source in a single pass.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="pointers">JSON Pointers.</param>
+    /// <returns>Values addressed by pointers (nullptr for none).</returns>
+    std::vector<std::unique_ptr<JNode>> JSON::extract(ISource &source, const std::vector<std::string> &pointers)
+    {
+        return (WorkScope(*this).json.extractAll(source, pointers));
+    }
+    /// <summary>
+    /// Extract the values addressed by a batch of JSON Pointers from a
+    /// buffer of JSON in a single pass.
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer contains JSON.</param>
+    /// <param name="pointers">JSON Pointers.</param>
+    /// <returns>Values addressed by pointers (nullptr for none).</returns>
+    std::vector<std::unique_ptr<JNode>> JSON::extractFromBuffer(std::string_view jsonBuffer, const std::vector<std::string> &pointers)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        SpanSource source(jsonBuffer);
+        return (WorkScope(*this).json.extractAll(source, pointers));
+    }
+    /// <summary>
+    /// Extract the values addressed by a batch of JSON Pointers from a
+    /// file of JSON in a single pass; the file is memory mapped (or read in
+    /// whole).
+    /// </summary>
+    /// <param name="sourceFileName">JSON source file name</param>
+    /// <param name="pointers">JSON Pointers.</param>
+    /// <returns>Values addressed by pointers (nullptr for none).</returns>
+    std::vector<std::unique_ptr<JNode>> JSON::extractFromFile(const std::string &sourceFileName, const std::vector<std::string> &pointers)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource source(sourceFileName);
+        return (WorkScope(*this).json.extractAll<SpanSource>(source, pointers));
+    }
+} // namespace H4
@@ -0,0 +1,259 @@
+//
+// Class: JSON
+//
+// Description: Stage one of a two stage JSON parse. A contiguous JSON
+// buffer is classified 64 bytes at a time (using AVX2 or SSE2 where the
+// target supports it, otherwise a scalar loop) into bitmaps of quotes,
+// backslashes, whitespace and structural characters. Escaped quotes are
+// removed and the extent of every string found with a prefix XOR so that
+// the offsets of all quotes, structural characters and the first byte of
+// every other token can be written to an index. Stage two (IndexedSource)
+// then uses the index to skip whitespace and whole strings in one step
+// rather than examining each byte in turn. The block algorithm is the one
+// described for simdjson (https://arxiv.org/abs/1902.08318).
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    //
+    // Bitmaps (bit n for byte n) of the characters of interest in a block.
+    //
+    struct BlockMasks
+    {
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t whiteSpace;
+        std::uint64_t structural;
+    };
+    static constexpr std::size_t kBlockSize = 64;
+    static constexpr std::uint64_t kEvenBits = 0x5555555555555555ULL;
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Classify a 64 byte block into character bitmaps. Whitespace is the
+    /// same set that std::iswspace() accepts for single bytes so that the
+    /// indexed parse skips exactly what the byte at a time parse does.
+    /// </summary>
+    /// <param name="block">64 bytes of JSON.</param>
+    /// <param name="masks">Bitmaps for block.</param>
+    /// <returns></returns>
+#if defined(__AVX2__)
+    static inline void classifyBlock(const char *block, BlockMasks &masks)
+    {
+        masks = BlockMasks{0, 0, 0, 0};
+        for (std::size_t offset = 0; offset < kBlockSize; offset += 32)
+        {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + offset));
+            __m256i controls = _mm256_sub_epi8(bytes, _mm256_set1_epi8('\t'));
+            __m256i whiteSpace = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                                                 _mm256_cmpeq_epi8(_mm256_min_epu8(controls, _mm256_set1_epi8('\r' - '\t')), controls));
+            __m256i structural = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')),
+                                                                 _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}'))),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')),
+                                                                 _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+            structural = _mm256_or_si256(structural, _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')),
+                                                                     _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))));
+            masks.quote |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'))) << offset;
+            masks.backslash |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))) << offset;
+            masks.whiteSpace |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(whiteSpace) << offset;
+            masks.structural |= (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(structural) << offset;
+        }
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    static inline void classifyBlock(const char *block, BlockMasks &masks)
+    {
+        masks = BlockMasks{0, 0, 0, 0};
+        for (std::size_t offset = 0; offset < kBlockSize; offset += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + offset));
+            __m128i controls = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+            __m128i whiteSpace = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                              _mm_cmpeq_epi8(_mm_min_epu8(controls, _mm_set1_epi8('\r' - '\t')), controls));
+            __m128i structural = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')),
+                                                           _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))),
+                                              _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')),
+                                                           _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+            structural = _mm_or_si128(structural, _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')),
+                                                               _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+            masks.quote |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'))) << offset;
+            masks.backslash |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))) << offset;
+            masks.whiteSpace |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(whiteSpace) << offset;
+            masks.structural |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(structural) << offset;
+        }
+    }
+#else
+    static inline void classifyBlock(const char *block, BlockMasks &masks)
+    {
+        masks = BlockMasks{0, 0, 0, 0};
+        for (std::size_t offset = 0; offset < kBlockSize; offset++)
+        {
+            std::uint64_t bit = 1ULL << offset;
+            switch (block[offset])
+            {
+            case '"':
+                masks.quote |= bit;
+                break;
+            case '\\':
+                masks.backslash |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\v':
+            case '\f':
+            case '\r':
+                masks.whiteSpace |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                masks.structural |= bit;
+                break;
+            }
+        }
+    }
+#endif
+    /// <summary>
+    /// Find the characters in a block that are escaped by a preceding odd
+    /// length run of backslashes (a run may carry over from the previous
+    /// block).
+    /// </summary>
+    /// <param name="backslash">Backslash bitmap for block.</param>
+    /// <param name="prevEscaped">1 if the first byte is escaped; updated for next block.</param>
+    /// <returns>Bitmap of escaped characters.</returns>
+    static inline std::uint64_t findEscaped(std::uint64_t backslash, std::uint64_t &prevEscaped)
+    {
+        backslash &= ~prevEscaped;
+        std::uint64_t followsEscape = (backslash << 1) | prevEscaped;
+        std::uint64_t oddSequenceStarts = backslash & ~kEvenBits & ~followsEscape;
+        std::uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+        prevEscaped = (sequencesStartingOnEvenBits < oddSequenceStarts) ? 1 : 0;
+        std::uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+        return ((kEvenBits ^ invertMask) & followsEscape);
+    }
+    /// <summary>
+    /// Prefix XOR of a bitmap; applied to unescaped quotes it sets the bits
+    /// from each opening quote up to (but not including) its closing quote.
+    /// </summary>
+    /// <param name="bits">Bitmap.</param>
+    /// <returns>Prefix XOR of bitmap.</returns>
+    static inline std::uint64_t prefixXOR(std::uint64_t bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return (bits);
+    }
+    /// <summary>
+    /// Index of lowest set bit in a (non-zero) bitmap.
+    /// </summary>
+    /// <param name="bits">Bitmap.</param>
+    /// <returns>Bit index.</returns>
+    static inline unsigned trailingZeros(std::uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return ((unsigned)index);
+#else
+        return ((unsigned)__builtin_ctzll(bits));
+#endif
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Build the structural index for a buffer of JSON. This holds the
+    /// offsets, in order, of every unescaped quote (opening and closing),
+    /// every structural character outside a string and the first byte of
+    /// every other token outside a string that follows whitespace or a
+    /// structural character.
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer of JSON.</param>
+    /// <param name="index">Structural index.</param>
+    /// <returns></returns>
+    void buildStructuralIndex(std::string_view jsonBuffer, std::vector<std::uint32_t> &index)
+    {
+        if (jsonBuffer.size() >= IndexedSource::kMaxIndexedSize)
+        {
+            throw std::length_error("JSON buffer too large to be indexed.");
+        }
+        index.clear();
+        // Typical JSON has a token every 8 or so bytes; denser JSON just
+        // grows the index
+        index.reserve(jsonBuffer.size() / 8);
+        std::uint64_t prevEscaped = 0;
+        std::uint64_t prevInString = 0;
+        std::uint64_t prevSeparator = 1;
+        char lastBlock[kBlockSize];
+        for (std::size_t blockStart = 0; blockStart < jsonBuffer.size(); blockStart += kBlockSize)
+        {
+            const char *block = jsonBuffer.data() + blockStart;
+            if (jsonBuffer.size() - blockStart < kBlockSize)
+            {
+                // Pad final block with whitespace which is never indexed
+                std::memset(lastBlock, ' ', kBlockSize);
+                std::memcpy(lastBlock, block, jsonBuffer.size() - blockStart);
+                block = lastBlock;
+            }
+            BlockMasks masks;
+            classifyBlock(block, masks);
+            std::uint64_t quotes = masks.quote & ~findEscaped(masks.backslash, prevEscaped);
+            std::uint64_t inString = prefixXOR(quotes) ^ prevInString;
+            prevInString = (inString >> 63) ? ~0ULL : 0;
+            std::uint64_t separators = masks.whiteSpace | masks.structural;
+            std::uint64_t tokenStarts = ~masks.whiteSpace & ((separators << 1) | prevSeparator);
+            prevSeparator = separators >> 63;
+            std::uint64_t entries = quotes | ((masks.structural | tokenStarts) & ~inString);
+            while (entries != 0)
+            {
+                index.push_back((std::uint32_t)(blockStart + trailingZeros(entries)));
+                entries &= entries - 1;
+            }
+        }
+    }
+} // namespace H4
@@ -0,0 +1,396 @@
+//
+// Class: JSON
+//
+// Description: Lazy JSON parse. Rather than building the whole JNode tree
+// up front only the extent of the top level value is found; objects and
+// arrays keep the span of their JSON and are parsed one level at a time the
+// first time they are accessed, and strings keep their escaped form until
+// first read. The extent of every object/array is found in one scan of the
+// top level value that only looks for brackets and string quotes (and
+// checks the maximum nesting depth), so a consumer that reads a few fields
+// of a large document pays for little more than a scan of it. The JSON being
+// parsed (buffer or mapped file) has to remain until the nodes are freed;
+// syntax errors inside a value are only reported when it is accessed.
+// Lazily parsed nodes are not safe to access concurrently. Numeric arrays
+// are not packed even if JSON::packNumbers() is set, as they are only
+// parsed when their elements are accessed, which would unpack them again.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    //
+    // Bytes that need to be looked at when finding the end of an object or
+    // array (brackets and quotes).
+    //
+    struct ContainerBytes
+    {
+        constexpr ContainerBytes() : table()
+        {
+            table[(unsigned char)'"'] = true;
+            table[(unsigned char)'{'] = true;
+            table[(unsigned char)'}'] = true;
+            table[(unsigned char)'['] = true;
+            table[(unsigned char)']'] = true;
+        }
+        bool table[256];
+    };
+    static constexpr ContainerBytes kContainerBytes;
+    //
+    // Position of an object/array and of the byte after it in the JSON
+    // being lazily parsed.
+    //
+    struct ContainerExtent
+    {
+        std::size_t start;
+        std::size_t end;
+    };
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    //
+    // Context shared by the nodes created from a lazily parsed buffer; it
+    // holds a copy of the JSON object that parsed it (so its translator
+    // and settings), the mapped file if there is one and the extent of
+    // every object/array in the JSON (in order of position).
+    //
+    struct JNodeLazyContext : std::enable_shared_from_this<JNodeLazyContext>
+    {
+    public:
+        JNodeLazyContext(const JSON &json) : json(json)
+        {
+        }
+        void scanContainers(std::string_view jsonBuffer, std::size_t position);
+        std::size_t findContainerEnd(std::string_view lazyJSON, std::size_t position) const;
+        std::unique_ptr<JNode> parseValue(std::string_view lazyJSON, std::size_t &position);
+        void parseObject(std::string_view lazyJSON, JNodeObject &object);
+        void parseArray(std::string_view lazyJSON, JNodeArray &array);
+        void decodeString(std::pmr::string &string);
+        JSON json;
+        std::unique_ptr<MappedFileSource> file;
+        std::string_view document;
+        std::vector<ContainerExtent> containers;
+    };
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Byte at a position in some JSON (EOF past its end).
+    /// </summary>
+    /// <param name="lazyJSON">JSON.</param>
+    /// <param name="position">Position in JSON.</param>
+    /// <returns>Byte at position.</returns>
+    static inline char byteAt(std::string_view lazyJSON, std::size_t position)
+    {
+        return ((position < lazyJSON.size()) ? lazyJSON[position] : (char)EOF);
+    }
+    /// <summary>
+    /// Move past any whitespace.
+    /// </summary>
+    /// <param name="lazyJSON">JSON.</param>
+    /// <param name="position">Position in JSON.</param>
+    /// <returns>Position of next non-whitespace byte.</returns>
+    static inline std::size_t skipWhiteSpace(std::string_view lazyJSON, std::size_t position)
+    {
+        while ((position < lazyJSON.size()) && std::iswspace(lazyJSON[position]))
+        {
+            position++;
+        }
+        return (position);
+    }
+    /// <summary>
+    /// Find the closing quote of a string; a quote is escaped if preceded
+    /// by an odd number of backslashes.
+    /// </summary>
+    /// <param name="lazyJSON">JSON.</param>
+    /// <param name="position">Position of first byte after opening quote.</param>
+    /// <returns>Position of closing quote.</returns>
+    static std::size_t findStringEnd(std::string_view lazyJSON, std::size_t position)
+    {
+        for (;;)
+        {
+            const void *quote = std::memchr(lazyJSON.data() + position, '"', lazyJSON.size() - position);
+            if (quote == nullptr)
+            {
+                throw JSON::SyntaxError();
+            }
+            std::size_t end = static_cast<const char *>(quote) - lazyJSON.data();
+            std::size_t backslashes = 0;
+            while ((end - backslashes > position) && (lazyJSON[end - backslashes - 1] == '\\'))
+            {
+                backslashes++;
+            }
+            if ((backslashes & 1) == 0)
+            {
+                return (end);
+            }
+            position = end + 1;
+        }
+    }
+    /// <summary>
+    /// Scan the object/array (if any) at a position in the JSON being lazily
+    /// parsed, recording the extent of it and of every object/array within it. Only
+    /// bracket depth is followed; whether the brackets match and the
+    /// contents are valid is checked when each is parsed. It is an error to
+    /// go deeper than the maximum nesting depth.
+    /// </summary>
+    /// <param name="jsonBuffer">JSON being lazily parsed.</param>
+    /// <param name="position">Position of opening bracket.</param>
+    /// <returns></returns>
+    void JNodeLazyContext::scanContainers(std::string_view jsonBuffer, std::size_t position)
+    {
+        document = jsonBuffer;
+        if ((byteAt(jsonBuffer, position) != '{') && (byteAt(jsonBuffer, position) != '['))
+        {
+            return;
+        }
+        std::vector<std::size_t> open;
+        for (; position < jsonBuffer.size(); position++)
+        {
+            if (!kContainerBytes.table[(unsigned char)jsonBuffer[position]])
+            {
+                continue;
+            }
+            switch (jsonBuffer[position])
+            {
+            case '"':
+                position = findStringEnd(jsonBuffer, position + 1);
+                break;
+            case '{':
+            case '[':
+                if (open.size() >= json.m_maxNestingDepth)
+                {
+                    throw JSON::SyntaxError("Maximum nesting depth exceeded.");
+                }
+                open.push_back(containers.size());
+                containers.push_back(ContainerExtent{position, 0});
+                break;
+            default:
+                containers[open.back()].end = position + 1;
+                open.pop_back();
+                if (open.empty())
+                {
+                    return;
+                }
+            }
+        }
+        throw JSON::SyntaxError();
+    }
+    /// <summary>
+    /// Find the end of an object/array from the extents recorded when the
+    /// JSON was scanned.
+    /// </summary>
+    /// <param name="lazyJSON">JSON (part of the scanned JSON).</param>
+    /// <param name="position">Position of opening bracket.</param>
+    /// <returns>Position after closing bracket.</returns>
+    std::size_t JNodeLazyContext::findContainerEnd(std::string_view lazyJSON, std::size_t position) const
+    {
+        std::size_t offset = lazyJSON.data() - document.data();
+        auto container = std::lower_bound(containers.begin(), containers.end(), offset + position,
+                                          [](const ContainerExtent &extent, std::size_t start)
+                                          { return (extent.start < start); });
+        if ((container == containers.end()) || (container->start != offset + position))
+        {
+            throw JSON::SyntaxError();
+        }
+        return (container->end - offset);
+    }
+    /// <summary>
+    /// Create the node for the value at a position; objects, arrays and
+    /// strings are left to be parsed/decoded on first access.
+    /// </summary>
+    /// <param name="lazyJSON">JSON.</param>
+    /// <param name="position">Position of value; updated to after it.</param>
+    /// <returns>Value JNode.</returns>
+    std::unique_ptr<JNode> JNodeLazyContext::parseValue(std::string_view lazyJSON, std::size_t &position)
+    {
+        std::size_t start = position;
+        switch (byteAt(lazyJSON, position))
+        {
+        case '{':
+            position = findContainerEnd(lazyJSON, position);
+            return (std::make_unique<JNodeObject>(lazyJSON.substr(start, position - start), shared_from_this()));
+        case '[':
+            position = findContainerEnd(lazyJSON, position);
+            return (std::make_unique<JNodeArray>(lazyJSON.substr(start, position - start), shared_from_this()));
+        case '"':
+            position = findStringEnd(lazyJSON, position + 1) + 1;
+            return (std::make_unique<JNodeString>(lazyJSON.substr(start + 1, position - start - 2), shared_from_this()));
+        }
+        SpanSource source(lazyJSON.substr(position));
+        std::unique_ptr<JNode> jNode = json.parseJNodes(source);
+        position = lazyJSON.size() - source.bytesRemaining();
+        return (jNode);
+    }
+    /// <summary>
+    /// Parse the entries of a lazy object.
+    /// </summary>
+    /// <param name="lazyJSON">JSON of object.</param>
+    /// <param name="object">Object JNode.</param>
+    /// <returns></returns>
+    void JNodeLazyContext::parseObject(std::string_view lazyJSON, JNodeObject &object)
+    {
+        std::size_t position = 0;
+        do
+        {
+            position = skipWhiteSpace(lazyJSON, position + 1);
+            if (byteAt(lazyJSON, position) != '"')
+            {
+                throw JSON::SyntaxError();
+            }
+            std::size_t keyEnd = findStringEnd(lazyJSON, position + 1);
+            std::string key(json.m_jsonTranslator->fromEscapeSequences(lazyJSON.substr(position + 1, keyEnd - position - 1)));
+            position = skipWhiteSpace(lazyJSON, keyEnd + 1);
+            if (byteAt(lazyJSON, position) != ':')
+            {
+                throw JSON::SyntaxError();
+            }
+            position = skipWhiteSpace(lazyJSON, position + 1);
+            object.addEntry(key, parseValue(lazyJSON, position));
+            position = skipWhiteSpace(lazyJSON, position);
+        } while (byteAt(lazyJSON, position) == ',');
+        if (byteAt(lazyJSON, position) != '}')
+        {
+            throw JSON::SyntaxError();
+        }
+    }
+    /// <summary>
+    /// Parse the elements of a lazy array.
+    /// </summary>
+    /// <param name="lazyJSON">JSON of array.</param>
+    /// <param name="array">Array JNode.</param>
+    /// <returns></returns>
+    void JNodeLazyContext::parseArray(std::string_view lazyJSON, JNodeArray &array)
+    {
+        std::size_t position = 0;
+        do
+        {
+            position = skipWhiteSpace(lazyJSON, position + 1);
+            array.addEntry(parseValue(lazyJSON, position));
+            position = skipWhiteSpace(lazyJSON, position);
+        } while (byteAt(lazyJSON, position) == ',');
+        if (byteAt(lazyJSON, position) != ']')
+        {
+            throw JSON::SyntaxError();
+        }
+    }
+    /// <summary>
+    /// Decode the escape sequences of a lazy string in place.
+    /// </summary>
+    /// <param name="string">Escaped string.</param>
+    /// <returns></returns>
+    void JNodeLazyContext::decodeString(std::pmr::string &string)
+    {
+        std::string_view decoded = json.m_jsonTranslator->fromEscapeSequences(string);
+        if (decoded.data() != string.data())
+        {
+            string.assign(decoded.data(), decoded.size());
+        }
+    }
+    /// <summary>
+    /// Parse the entries of an object from its JSON. They are parsed into a
+    /// separate object and only moved into this one (and the context
+    /// released) once the whole object has parsed, so a syntax error leaves
+    /// it lazy and is reported again on every access.
+    /// </summary>
+    /// <returns></returns>
+    void JNodeObject::parseLazyJSON()
+    {
+        JNodeObject parsed;
+        m_lazyContext->parseObject(m_lazyJSON, parsed);
+        m_value = std::move(parsed.m_value);
+        m_lazyContext.reset();
+        m_lazyJSON = std::string_view();
+    }
+    /// <summary>
+    /// Parse the elements of an array from its JSON (as for an object).
+    /// </summary>
+    /// <returns></returns>
+    void JNodeArray::parseLazyJSON()
+    {
+        JNodeArray parsed;
+        m_lazyContext->parseArray(m_lazyJSON, parsed);
+        m_value = std::move(parsed.m_value);
+        m_lazyContext.reset();
+        m_lazyJSON = std::string_view();
+    }
+    /// <summary>
+    /// Decode the escape sequences of a string; the string is left escaped
+    /// (and lazy) if they are invalid.
+    /// </summary>
+    /// <returns></returns>
+    void JNodeString::decodeLazyJSON()
+    {
+        m_lazyContext->decodeString(m_value);
+        m_lazyContext.reset();
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Lazily parse JSON in a buffer (which must remain until the returned
+    /// nodes are freed). Only the extent of the top level value is found;
+    /// objects and arrays are parsed one level at a time when first
+    /// accessed and strings decoded when first read.
+    /// </summary>
+    /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
+    /// <returns>JNode structure.</returns>
+    std::unique_ptr<JNode> JSON::parseBufferLazy(std::string_view jsonBuffer)
+    {
+        if (jsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        std::shared_ptr<JNodeLazyContext> lazyContext = std::make_shared<JNodeLazyContext>(*this);
+        std::size_t position = skipWhiteSpace(jsonBuffer, 0);
+        lazyContext->scanContainers(jsonBuffer, position);
+        return (lazyContext->parseValue(jsonBuffer, position));
+    }
+    /// <summary>
+    /// Lazily parse JSON in a file; the file is memory mapped (or read in
+    /// whole) and kept until the returned nodes are freed.
+    /// </summary>
+    /// <param name=sourceFileName>JSON source file name</param>
+    /// <returns>JNode structure.</returns>
+    std::unique_ptr<JNode> JSON::parseFileLazy(const std::string &sourceFileName)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        std::shared_ptr<JNodeLazyContext> lazyContext = std::make_shared<JNodeLazyContext>(*this);
+        lazyContext->file = std::make_unique<MappedFileSource>(sourceFileName);
+        std::string_view jsonBuffer = lazyContext->file->remainingBytes();
+        std::size_t position = skipWhiteSpace(jsonBuffer, 0);
+        lazyContext->scanContainers(jsonBuffer, position);
+        return (lazyContext->parseValue(jsonBuffer, position));
+    }
+} // namespace H4
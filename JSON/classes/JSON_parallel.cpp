@@ -0,0 +1,298 @@
+//
+// Class: JSON
+//
+// Description: Parallel parse of JSON whose top level value is an array
+// (typically a large array of records). The structural index of the buffer
+// is built once and walked to find the commas that separate the top level
+// elements; the elements are then divided into runs of roughly equal size
+// that are parsed concurrently, each by its own copy of the JSON object
+// using the part of the index that covers its run, and the results are
+// moved into one JNodeArray in their original order. Any other JSON (or a
+// buffer too large to be indexed) is just parsed as by parseBuffer().
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <thread>
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    // Buffers smaller than this are not worth splitting between threads
+    static constexpr std::size_t kMinParallelSize = 64 * 1024;
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Find the positions of the opening bracket, separating commas and
+    /// closing bracket of a top level array from its structural index.
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer contains JSON array.</param>
+    /// <param name="index">Structural index of buffer.</param>
+    /// <returns>Element boundaries.</returns>
+    static std::vector<std::size_t> findElementBoundaries(std::string_view jsonBuffer, const std::vector<std::uint32_t> &index)
+    {
+        std::vector<std::size_t> boundaries;
+        int depth = 0;
+        for (auto offset : index)
+        {
+            switch (jsonBuffer[offset])
+            {
+            case '{':
+            case '[':
+                if (depth++ == 0)
+                {
+                    boundaries.push_back(offset);
+                }
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0)
+                {
+                    if (jsonBuffer[offset] != ']')
+                    {
+                        throw JSON::SyntaxError();
+                    }
+                    boundaries.push_back(offset);
+                    return (boundaries);
+                }
+                break;
+            case ',':
+                if (depth == 1)
+                {
+                    boundaries.push_back(offset);
+                }
+                break;
+            }
+        }
+        throw JSON::SyntaxError();
+    }
+    /// <summary>
+    /// Split the elements of a top level array into runs (at most one per
+    /// thread and none smaller than kMinParallelSize) of about the same
+    /// number of bytes. Only whitespace may follow the array. A buffer too
+    /// large to be indexed is left as a single run.
+    /// </summary>
+    /// <param name="jsonBuffer">Buffer contains JSON array.</param>
+    /// <param name="index">Structural index of buffer.</param>
+    /// <param name="threadCount">Number of threads runs are for.</param>
+    /// <returns>Runs of comma separated elements.</returns>
+    std::vector<std::string_view> JSON::splitArrayIntoRuns(std::string_view jsonBuffer, const std::vector<std::uint32_t> &index, unsigned threadCount)
+    {
+        std::size_t first = jsonBuffer.find_first_not_of(" \t\n\v\f\r");
+        if ((first == std::string_view::npos) || (jsonBuffer[first] != '['))
+        {
+            throw JSON::SyntaxError();
+        }
+        if (jsonBuffer.size() >= IndexedSource::kMaxIndexedSize)
+        {
+            // No index so the elements are one run checked as it is parsed
+            std::size_t last = jsonBuffer.find_last_not_of(" \t\n\v\f\r");
+            if (jsonBuffer[last] != ']')
+            {
+                throw JSON::SyntaxError();
+            }
+            return (std::vector<std::string_view>{jsonBuffer.substr(first + 1, last - first - 1)});
+        }
+        std::vector<std::size_t> boundaries = findElementBoundaries(jsonBuffer, index);
+        if (jsonBuffer.find_first_not_of(" \t\n\v\f\r", boundaries.back() + 1) != std::string_view::npos)
+        {
+            throw JSON::SyntaxError();
+        }
+        std::size_t runCount = std::min<std::size_t>(threadCount, jsonBuffer.size() / kMinParallelSize + 1);
+        std::vector<std::string_view> runs;
+        std::size_t runStart = 0;
+        std::size_t runSize = (boundaries.back() - boundaries.front()) / runCount + 1;
+        for (std::size_t boundary = 1; boundary < boundaries.size(); boundary++)
+        {
+            if ((boundary == boundaries.size() - 1) ||
+                (boundaries[boundary] - boundaries[runStart] >= runSize))
+            {
+                runs.push_back(jsonBuffer.substr(boundaries[runStart] + 1, boundaries[boundary] - boundaries[runStart] - 1));
+                runStart = boundary;
+            }
+        }
+        return (runs);
+    }
+    /// <summary>
+    /// Parse a run of comma separated array elements into an array. If
+    /// numeric arrays are being packed, numbers are packed into it until the
+    /// first element that cannot be, when those packed so far are unpacked
+    /// (as by parseJNodes() for an array).
+    /// </summary>
+    /// <param name="source">Indexed source for run of elements.</param>
+    /// <param name="elements">Array of parsed elements.</param>
+    /// <returns></returns>
+    void JSON::parseElements(IndexedSource &source, JNodeArray &elements)
+    {
+        for (;;)
+        {
+            source.skipWhiteSpace();
+            std::unique_ptr<JNode> element;
+            if (m_packNumbers && ((source.currentByte() == '-') || std::isdigit((unsigned char)source.currentByte())))
+            {
+                element = parseNumber(source, &elements);
+            }
+            else
+            {
+                element = parseJNodes(source);
+            }
+            if (element != nullptr)
+            {
+                elements.addEntry(std::move(element));
+            }
+            source.skipWhiteSpace();
+            if (!source.bytesToParse())
+            {
+                return;
+            }
+            if (source.currentByte() != ',')
+            {
+                throw JSON::SyntaxError();
+            }
+            source.moveToNextByte();
+        }
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// Parse JSON in a buffer, the elements of a top level array being
+    /// parsed concurrently. A custom translator has to be safe to call from
+    /// several threads at once (as the default one is).
+    /// </summary>
+    /// <param name=jsonBuffer>Buffer contains JSON to be parsed.</param>
+    /// <param name=threadCount>Number of threads to use (0 for one per core).</param>
+    /// <returns>JNode structure.</returns>
+    std::unique_ptr<JNode> JSON::parseBufferParallel(std::string_view jsonBuffer, unsigned threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        std::size_t first = jsonBuffer.find_first_not_of(" \t\n\v\f\r");
+        if ((threadCount == 1) || (jsonBuffer.size() < kMinParallelSize) || (jsonBuffer.size() >= IndexedSource::kMaxIndexedSize) ||
+            (first == std::string_view::npos) || (jsonBuffer[first] != '['))
+        {
+            return (parseBuffer(jsonBuffer));
+        }
+        std::vector<std::uint32_t> index;
+        buildStructuralIndex(jsonBuffer, index);
+        std::vector<std::string_view> runs = splitArrayIntoRuns(jsonBuffer, index, threadCount);
+        std::vector<JNodeArray> runElements(runs.size());
+        std::vector<std::exception_ptr> runErrors(runs.size());
+        std::vector<std::thread> workers;
+        try
+        {
+            for (std::size_t run = 0; run < runs.size(); run++)
+            {
+                workers.emplace_back([&, run]()
+                                     {
+                                         try
+                                         {
+                                             WorkScope workScope(*this);
+                                             IndexedSource source(runs[run], jsonBuffer.data(), index);
+                                             workScope.json.parseElements(source, runElements[run]);
+                                         }
+                                         catch (...)
+                                         {
+                                             runErrors[run] = std::current_exception();
+                                         } });
+            }
+        }
+        catch (...)
+        {
+            // Threads already started are joined before the failure to start
+            // another is passed on
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            throw;
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (auto &runError : runErrors)
+        {
+            if (runError != nullptr)
+            {
+                std::rethrow_exception(runError);
+            }
+        }
+        std::unique_ptr<JNode> array = std::make_unique<JNodeArray>();
+        JNodeArray &jNodeArray = JNodeRef<JNodeArray>(*array);
+        if (std::all_of(runElements.begin(), runElements.end(), [](const JNodeArray &elements)
+                        { return (elements.isPacked()); }))
+        {
+            // A top level array of numbers is packed as by parseBuffer()
+            for (auto &elements : runElements)
+            {
+                for (std::size_t element = 0; element < elements.packedSize(); element++)
+                {
+                    jNodeArray.packNumber(elements.getPackedNumeric(element));
+                }
+            }
+            return (array);
+        }
+        std::size_t elementCount = 0;
+        for (auto &elements : runElements)
+        {
+            elementCount += elements.getArray().size();
+        }
+        jNodeArray.getArray().reserve(elementCount);
+        for (auto &elements : runElements)
+        {
+            for (auto &element : elements.getArray())
+            {
+                jNodeArray.addEntry(std::move(element));
+            }
+        }
+        return (array);
+    }
+    /// <summary>
+    /// Parse JSON in a file, the elements of a top level array being parsed
+    /// concurrently. The file is memory mapped (or read in whole).
+    /// </summary>
+    /// <param name=sourceFileName>JSON source file name</param>
+    /// <param name=threadCount>Number of threads to use (0 for one per core).</param>
+    /// <returns>JNode structure.</returns>
+    std::unique_ptr<JNode> JSON::parseFileParallel(const std::string &sourceFileName, unsigned threadCount)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource file(sourceFileName);
+        return (parseBufferParallel(file.remainingBytes(), threadCount));
+    }
+} // namespace H4
@@ -0,0 +1,730 @@
+//
+// Class: JSON
+//
+// Description: JSON parser code. The parse methods are templated on the
+// type of source being read so that contiguous buffers (SpanSource) are
+// parsed with inlined pointer increments rather than a virtual call per
+// byte; custom ISource implementations go through the same code path.
+// Buffers and files are parsed from an IndexedSource (stage two of a two
+// stage parse) which overloads whitespace skipping and string extraction
+// to use its structural index.
+// Templates are explicitly instantiated for each source type used by the
+// library at the bottom of this file.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+#include "JSONDestinations.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <cwctype>
+#include <type_traits>
+#include <charconv>
+#include <cmath>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Create a JNode of the given type. If a parse is taking place into
+    /// a JSONDocument then the node (and any storage it has) is placed in
+    /// the document arena, otherwise it is heap allocated.
+    /// </summary>
+    /// <param name="args">JNode constructor arguments.</param>
+    /// <returns>Created JNode.</returns>
+    template <typename T, typename... Args>
+    std::unique_ptr<JNode> JSON::makeJNode(Args &&...args)
+    {
+        if (m_arena == nullptr)
+        {
+            return (std::make_unique<T>(std::forward<Args>(args)...));
+        }
+        T *jNode;
+        if constexpr (std::is_constructible_v<T, Args..., std::pmr::memory_resource *>)
+        {
+            jNode = new (m_arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)..., m_arena);
+        }
+        else
+        {
+            jNode = new (m_arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        jNode->arenaOwned = true;
+        return (std::unique_ptr<JNode>(jNode));
+    }
+    /// <summary>
+    /// Move to next non-whitespace character in JSON encoded source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::ignoreWhiteSpace(T &source)
+    {
+        while (source.bytesToParse() && std::iswspace(source.currentByte()))
+        {
+            source.moveToNextByte();
+        }
+    }
+    /// <summary>
+    /// Move to next non-whitespace character using the structural index of
+    /// an indexed source.
+    /// </summary>
+    /// <param name="source">Indexed source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    inline void JSON::ignoreWhiteSpace(IndexedSource &source)
+    {
+        source.skipWhiteSpace();
+    }
+    /// <summary>
+    /// Extract a string from an indexed source; its closing quote is found
+    /// from the structural index and the contents returned in place.
+    /// </summary>
+    /// <param name="source">Indexed source for JSON encoded bytes.</param>
+    /// <returns>Extracted string</returns>
+    inline std::string_view JSON::extractString(IndexedSource &source)
+    {
+        std::string_view contents;
+        if (!source.skipString(contents))
+        {
+            throw JSON::SyntaxError();
+        }
+        return (contents);
+    }
+    /// <summary>
+    /// Extract a string from a JSON encoded source stream. The string is
+    /// left in the work buffer so is only valid until the next extract.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Extracted string</returns>
+    template <typename T>
+    std::string_view JSON::extractString(T &source)
+    {
+        m_workBuffer.clear();
+        source.moveToNextByte();
+        while (source.bytesToParse() && source.currentByte() != '"')
+        {
+            if (source.currentByte() == '\\')
+            {
+                m_workBuffer += source.currentByte();
+                source.moveToNextByte();
+                if (!source.bytesToParse())
+                {
+                    break;
+                }
+            }
+            m_workBuffer += source.currentByte();
+            source.moveToNextByte();
+        }
+        if (!source.bytesToParse())
+        {
+            throw JSON::SyntaxError();
+        }
+        source.moveToNextByte();
+        return (m_workBuffer);
+    }
+    /// <summary>
+    /// Parse a string from a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    std::unique_ptr<JNode> JSON::parseString(T &source)
+    {
+        return (makeJNode<JNodeString>(m_jsonTranslator->fromEscapeSequences(extractString(source))));
+    }
+    /// <summary>
+    /// Append a run of decimal digits from a JSON source stream to the
+    /// work buffer, there having to be at least one.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    inline void JSON::extractDigits(T &source)
+    {
+        if (!source.bytesToParse() || !std::isdigit(source.currentByte()))
+        {
+            throw JSON::SyntaxError();
+        }
+        do
+        {
+            m_workBuffer += source.currentByte();
+            source.moveToNextByte();
+        } while (source.bytesToParse() && std::isdigit(source.currentByte()));
+    }
+    /// <summary>
+    /// Extract a number from a JSON source stream checking it against the
+    /// JSON number grammar (-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?)
+    /// and converting it once to its native value. The number text is
+    /// left in the work buffer.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Extracted numeric value.</returns>
+    template <typename T>
+    JNumeric JSON::extractNumber(T &source)
+    {
+        m_workBuffer.clear();
+        if (source.currentByte() == '-')
+        {
+            m_workBuffer += '-';
+            source.moveToNextByte();
+        }
+        if (source.bytesToParse() && source.currentByte() == '0')
+        {
+            m_workBuffer += '0';
+            source.moveToNextByte();
+        }
+        else
+        {
+            extractDigits(source);
+        }
+        if (source.bytesToParse() && source.currentByte() == '.')
+        {
+            m_workBuffer += '.';
+            source.moveToNextByte();
+            extractDigits(source);
+        }
+        if (source.bytesToParse() && (source.currentByte() == 'e' || source.currentByte() == 'E'))
+        {
+            m_workBuffer += source.currentByte();
+            source.moveToNextByte();
+            if (source.bytesToParse() && (source.currentByte() == '+' || source.currentByte() == '-'))
+            {
+                m_workBuffer += source.currentByte();
+                source.moveToNextByte();
+            }
+            extractDigits(source);
+        }
+        // Number must not run on into anything that could be part of one
+        if (source.bytesToParse())
+        {
+            switch (source.currentByte())
+            {
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '.':
+            case 'e':
+            case 'E':
+            case '+':
+            case '-':
+                throw JSON::SyntaxError();
+            }
+        }
+        JNumeric numeric;
+        if (!JNumeric::fromText(m_workBuffer, numeric))
+        {
+            throw JSON::SyntaxError();
+        }
+        return (numeric);
+    }
+    /// <summary>
+    /// Extract a boolean from a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Boolean value.</returns>
+    template <typename T>
+    bool JSON::extractBoolean(T &source)
+    {
+        m_workBuffer.clear();
+        m_workBuffer += source.currentByte();
+        source.moveToNextByte();
+        while (source.bytesToParse() && std::isalpha(source.currentByte()))
+        {
+            m_workBuffer += source.currentByte();
+            source.moveToNextByte();
+        }
+        if (m_workBuffer == "true")
+        {
+            return (true);
+        }
+        else if (m_workBuffer == "false")
+        {
+            return (false);
+        }
+        throw JSON::SyntaxError();
+    }
+    /// <summary>
+    /// Extract a null from a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::extractNull(T &source)
+    {
+        m_workBuffer.clear();
+        m_workBuffer += source.currentByte();
+        source.moveToNextByte();
+        while (source.bytesToParse() && std::isalpha(source.currentByte()))
+        {
+            m_workBuffer += source.currentByte();
+            source.moveToNextByte();
+        }
+        if (m_workBuffer != "null")
+        {
+            throw JSON::SyntaxError();
+        }
+    }
+    /// <summary>
+    /// Parse a number from a JSON source stream. A number that is an element
+    /// of an array is packed into the array if numeric arrays are being
+    /// packed and it can be, no JNode then being returned.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="jNodeArray">Array being parsed into (or nullptr).</param>
+    /// <returns>Number JNode or nullptr if packed.</returns>
+    template <typename T>
+    std::unique_ptr<JNode> JSON::parseNumber(T &source, JNodeArray *jNodeArray)
+    {
+        JNumeric numeric = extractNumber(source);
+        // Text of numbers too large for a double is kept so it is not lost
+        if (m_keepNumberText || ((numeric.kind == JNumeric::Kind::floatingPoint) && !std::isfinite(numeric.floatingPoint)))
+        {
+            return (makeJNode<JNodeNumber>(numeric, std::string_view(m_workBuffer)));
+        }
+        if (m_packNumbers && (jNodeArray != nullptr) && jNodeArray->packNumber(numeric))
+        {
+            return (nullptr);
+        }
+        return (makeJNode<JNodeNumber>(numeric));
+    }
+    /// <summary>
+    /// Parse a boolean from a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    std::unique_ptr<JNode> JSON::parseBoolean(T &source)
+    {
+        return (makeJNode<JNodeBoolean>(extractBoolean(source)));
+    }
+    /// <summary>
+    /// Parse a null from a JSON source stream.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    std::unique_ptr<JNode> JSON::parseNull(T &source)
+    {
+        extractNull(source);
+        return (makeJNode<JNodeNull>());
+    }
+    /// <summary>
+    /// Push an object/array onto the parse stack and move past its opening
+    /// bracket; it is an error to go deeper than the maximum nesting depth.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="nodeType">Object or array.</param>
+    /// <param name="jNode">Object/array JNode (nullptr if none built).</param>
+    /// <param name="base">Stack size at start of parse.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::pushContainer(T &source, JNodeType nodeType, JNode *jNode, std::size_t base)
+    {
+        if (m_jNodeStack.size() - base >= m_maxNestingDepth)
+        {
+            throw JSON::SyntaxError("Maximum nesting depth exceeded.");
+        }
+        m_jNodeStack.push_back(JNodeFrame{nodeType, jNode, m_jValueStack.size()});
+        source.moveToNextByte();
+    }
+    /// <summary>
+    /// Extract an object key and move past the colon that follows it.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Translated key (valid until the next extract).</returns>
+    template <typename T>
+    std::string_view JSON::parseKey(T &source)
+    {
+        ignoreWhiteSpace(source);
+        std::string_view key = m_jsonTranslator->fromEscapeSequences(extractString(source));
+        ignoreWhiteSpace(source);
+        if (source.currentByte() != ':')
+        {
+            throw JSON::SyntaxError();
+        }
+        source.moveToNextByte();
+        return (key);
+    }
+    /// <summary>
+    /// Move past the comma or closing bracket that follows a value in an
+    /// object/array.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="nodeType">Object or array.</param>
+    /// <returns>true if another entry follows, false if object/array closed.</returns>
+    template <typename T>
+    bool JSON::moveToNextEntry(T &source, JNodeType nodeType)
+    {
+        ignoreWhiteSpace(source);
+        if (source.currentByte() == ',')
+        {
+            source.moveToNextByte();
+            return (true);
+        }
+        if (source.currentByte() != ((nodeType == JNodeType::object) ? '}' : ']'))
+        {
+            throw JSON::SyntaxError();
+        }
+        source.moveToNextByte();
+        return (false);
+    }
+    /// <summary>
+    /// Parse JSON source stream producing a JNode structure reprentation of
+    /// it. Objects/arrays are added to their parent as soon as they are
+    /// opened and kept on an explicit stack while their entries are parsed,
+    /// so nesting depth is not limited by the native stack.
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns></returns>
+    template <typename T>
+    std::unique_ptr<JNode> JSON::parseJNodes(T &source)
+    {
+        std::size_t base = m_jNodeStack.size();
+        std::unique_ptr<JNode> jNodeRoot;
+        std::string key;
+        try
+        {
+            for (;;)
+            {
+                if ((m_jNodeStack.size() > base) && (m_jNodeStack.back().nodeType == JNodeType::object))
+                {
+                    key = parseKey(source);
+                }
+                ignoreWhiteSpace(source);
+                std::unique_ptr<JNode> jNode;
+                switch (source.currentByte())
+                {
+                case '"':
+                    jNode = parseString(source);
+                    break;
+                case 't':
+                case 'f':
+                    jNode = parseBoolean(source);
+                    break;
+                case 'n':
+                    jNode = parseNull(source);
+                    break;
+                case '{':
+                    jNode = makeJNode<JNodeObject>();
+                    break;
+                case '[':
+                    jNode = makeJNode<JNodeArray>();
+                    break;
+                case '-':
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                    jNode = parseNumber(source, ((m_jNodeStack.size() > base) && (m_jNodeStack.back().nodeType == JNodeType::array)) ? &JNodeRef<JNodeArray>(*m_jNodeStack.back().jNode) : nullptr);
+                    break;
+                default:
+                    throw JSON::SyntaxError();
+                }
+                JNode *value = jNode.get();
+                if (value == nullptr)
+                {
+                    // Number packed into its array
+                }
+                else if (m_jNodeStack.size() == base)
+                {
+                    jNodeRoot = std::move(jNode);
+                }
+                else if (m_jNodeStack.back().nodeType == JNodeType::object)
+                {
+                    JNodeRef<JNodeObject>(*m_jNodeStack.back().jNode).addEntry(key, std::move(jNode));
+                }
+                else
+                {
+                    JNodeRef<JNodeArray>(*m_jNodeStack.back().jNode).addEntry(std::move(jNode));
+                }
+                if ((value != nullptr) && ((value->nodeType == JNodeType::object) || (value->nodeType == JNodeType::array)))
+                {
+                    pushContainer(source, value->nodeType, value, base);
+                    continue;
+                }
+                while ((m_jNodeStack.size() > base) && !moveToNextEntry(source, m_jNodeStack.back().nodeType))
+                {
+                    m_jNodeStack.pop_back();
+                }
+                if (m_jNodeStack.size() == base)
+                {
+                    return (jNodeRoot);
+                }
+            }
+        }
+        catch (...)
+        {
+            m_jNodeStack.resize(base);
+            throw;
+        }
+    }
+    /// <summary>
+    /// Parse JSON source stream raising an event on the passed in handler
+    /// for each value (and object/array start and end) found rather than
+    /// building a JNode structure. Open objects/arrays are kept on an
+    /// explicit stack as for parseJNodes().
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <param name="handler">Handler for parse events.</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::parseEvents(T &source, IHandler &handler)
+    {
+        std::size_t base = m_jNodeStack.size();
+        try
+        {
+            for (;;)
+            {
+                if ((m_jNodeStack.size() > base) && (m_jNodeStack.back().nodeType == JNodeType::object))
+                {
+                    handler.onKey(parseKey(source));
+                }
+                ignoreWhiteSpace(source);
+                switch (source.currentByte())
+                {
+                case '"':
+                    handler.onString(m_jsonTranslator->fromEscapeSequences(extractString(source)));
+                    break;
+                case 't':
+                case 'f':
+                    handler.onBoolean(extractBoolean(source));
+                    break;
+                case 'n':
+                    extractNull(source);
+                    handler.onNull();
+                    break;
+                case '{':
+                    handler.onObjectStart();
+                    pushContainer(source, JNodeType::object, nullptr, base);
+                    continue;
+                case '[':
+                    handler.onArrayStart();
+                    pushContainer(source, JNodeType::array, nullptr, base);
+                    continue;
+                case '-':
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                {
+                    JNumeric numeric = extractNumber(source);
+                    handler.onNumber(numeric, m_workBuffer);
+                    break;
+                }
+                default:
+                    throw JSON::SyntaxError();
+                }
+                while (m_jNodeStack.size() > base)
+                {
+                    JNodeType nodeType = m_jNodeStack.back().nodeType;
+                    if (moveToNextEntry(source, nodeType))
+                    {
+                        break;
+                    }
+                    m_jNodeStack.pop_back();
+                    if (nodeType == JNodeType::object)
+                    {
+                        handler.onObjectEnd();
+                    }
+                    else
+                    {
+                        handler.onArrayEnd();
+                    }
+                }
+                if (m_jNodeStack.size() == base)
+                {
+                    return;
+                }
+            }
+        }
+        catch (...)
+        {
+            m_jNodeStack.resize(base);
+            throw;
+        }
+    }
+    /// <summary>
+    /// Parse JSON source stream producing a compact JValue representation
+    /// of it; all out of line storage comes from m_arena. The entries of
+    /// each open object/array (keys and values alternating for an object)
+    /// are gathered on the JValue stack and copied to the arena as one
+    /// contiguous run when it closes. Open objects/arrays are kept on an
+    /// explicit stack as for parseJNodes().
+    /// </summary>
+    /// <param name="source">Source for JSON encoded bytes.</param>
+    /// <returns>Root JValue.</returns>
+    template <typename T>
+    JValue JSON::parseJValues(T &source)
+    {
+        std::size_t base = m_jNodeStack.size();
+        std::size_t jValueBase = m_jValueStack.size();
+        try
+        {
+            for (;;)
+            {
+                if ((m_jNodeStack.size() > base) && (m_jNodeStack.back().nodeType == JNodeType::object))
+                {
+                    m_jValueStack.push_back(JValue::makeString(parseKey(source), m_arena));
+                }
+                ignoreWhiteSpace(source);
+                JValue jValue;
+                switch (source.currentByte())
+                {
+                case '"':
+                    jValue = JValue::makeString(m_jsonTranslator->fromEscapeSequences(extractString(source)), m_arena);
+                    break;
+                case 't':
+                case 'f':
+                    jValue = JValue::makeBoolean(extractBoolean(source));
+                    break;
+                case 'n':
+                    extractNull(source);
+                    break;
+                case '{':
+                    pushContainer(source, JNodeType::object, nullptr, base);
+                    continue;
+                case '[':
+                    pushContainer(source, JNodeType::array, nullptr, base);
+                    continue;
+                case '-':
+                case '0':
+                case '1':
+                case '2':
+                case '3':
+                case '4':
+                case '5':
+                case '6':
+                case '7':
+                case '8':
+                case '9':
+                    jValue = JValue::makeNumber(extractNumber(source));
+                    break;
+                default:
+                    throw JSON::SyntaxError();
+                }
+                // Add value to the innermost open object/array; any it
+                // finishes are built and added to their parent in turn.
+                while (m_jNodeStack.size() > base)
+                {
+                    m_jValueStack.push_back(jValue);
+                    JNodeFrame &frame = m_jNodeStack.back();
+                    if (moveToNextEntry(source, frame.nodeType))
+                    {
+                        break;
+                    }
+                    jValue = JValue::makeContainer(frame.nodeType, m_jValueStack.data() + frame.firstJValue,
+                                                   m_jValueStack.size() - frame.firstJValue, m_arena);
+                    m_jValueStack.resize(frame.firstJValue);
+                    m_jNodeStack.pop_back();
+                }
+                if (m_jNodeStack.size() == base)
+                {
+                    return (jValue);
+                }
+            }
+        }
+        catch (...)
+        {
+            m_jNodeStack.resize(base);
+            m_jValueStack.resize(jValueBase);
+            throw;
+        }
+    }
+    /// <summary>
+    /// Remove all whitespace characters from a JSON source stream and
+    /// write them out to a JSON destination stream.
+    /// </summary>
+    /// <param name=source>JSON source stream</param>
+    /// <param name=jNode>JSON destination stream</param>
+    /// <returns></returns>
+    template <typename T>
+    void JSON::stripWhiteSpace(T &source, IDestination &destination)
+    {
+        while (source.bytesToParse())
+        {
+            ignoreWhiteSpace(source);
+            if (source.bytesToParse())
+            {
+                if (source.currentByte() == '"')
+                {
+                    std::string_view string = extractString(source);
+                    destination.addByte('"');
+                    destination.addBytes(string);
+                    destination.addByte('"');
+                }
+                else
+                {
+                    destination.addByte(source.currentByte());
+                    source.moveToNextByte();
+                }
+            }
+        }
+    }
+    // ===============================
+    // EXPLICIT TEMPLATE INSTANTIATION
+    // ===============================
+    template std::unique_ptr<JNode> JSON::parseJNodes<JSON::ISource>(JSON::ISource &source);
+    template std::unique_ptr<JNode> JSON::parseJNodes<IndexedSource>(IndexedSource &source);
+    template JValue JSON::parseJValues<IndexedSource>(IndexedSource &source);
+    template void JSON::parseEvents<JSON::ISource>(JSON::ISource &source, IHandler &handler);
+    template void JSON::parseEvents<SpanSource>(SpanSource &source, IHandler &handler);
+    template void JSON::parseEvents<IndexedSource>(IndexedSource &source, IHandler &handler);
+    template void JSON::stripWhiteSpace<SpanSource>(SpanSource &source, IDestination &destination);
+    template std::unique_ptr<JNode> JSON::parseJNodes<SpanSource>(SpanSource &source);
+    // Used by parseBufferParallel()
+    template std::unique_ptr<JNode> JSON::parseNumber<IndexedSource>(IndexedSource &source, JNodeArray *jNodeArray);
+    // Used by JSONReader
+    template void JSON::ignoreWhiteSpace<JSON::ISource>(JSON::ISource &source);
+    template void JSON::ignoreWhiteSpace<SpanSource>(SpanSource &source);
+    template std::string_view JSON::extractString<JSON::ISource>(JSON::ISource &source);
+    template std::string_view JSON::extractString<SpanSource>(SpanSource &source);
+    template JNumeric JSON::extractNumber<JSON::ISource>(JSON::ISource &source);
+    template JNumeric JSON::extractNumber<SpanSource>(SpanSource &source);
+    template bool JSON::extractBoolean<JSON::ISource>(JSON::ISource &source);
+    template bool JSON::extractBoolean<SpanSource>(SpanSource &source);
+    template void JSON::extractNull<JSON::ISource>(JSON::ISource &source);
+    template void JSON::extractNull<SpanSource>(SpanSource &source);
+} // namespace H4
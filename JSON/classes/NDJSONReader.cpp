@@ -0,0 +1,326 @@
+//
+// Class: NDJSONReader
+//
+// Description: Parser for newline delimited JSON (NDJSON/JSON Lines)
+// where each line holds one JSON record. The buffer/file (which is memory
+// mapped) is split at newline boundaries into chunks that are parsed on a
+// pool of worker threads, each with its own copy of the JSON object whose
+// settings (translator, nesting depth, number handling) the reader was
+// created with.
+// Records are passed to a callback on the calling thread either in the
+// order they appear or in the order their chunks are finished. At most a
+// fixed number of chunks are parsed ahead of the callback so memory use is
+// bounded however large the input. A record that fails to parse is passed
+// with its error rather than stopping the rest of the batch.
+//
+// Dependencies:   C17++ - Language standard features used.
+//
+// =================
+// CLASS DEFINITIONS
+// =================
+#include "JSONConfig.hpp"
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+#include "NDJSONReader.hpp"
+// ====================
+// CLASS IMPLEMENTATION
+// ====================
+//
+// C++ STL
+//
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <algorithm>
+#include <cstring>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ===========================
+    // PRIVATE TYPES AND CONSTANTS
+    // ===========================
+    //
+    // Chunks being parsed and their results shared between the workers
+    // and the thread delivering records.
+    //
+    struct NDJSONReader::ChunkQueue
+    {
+        std::mutex mutex;
+        std::condition_variable workReady;
+        std::condition_variable resultReady;
+        std::vector<std::string_view> chunks;
+        std::vector<std::vector<NDJSONReader::Record>> results;
+        std::vector<bool> completed;
+        std::deque<std::size_t> completedOrder;
+        std::size_t nextChunk = 0;
+        std::size_t deliveredChunks = 0;
+        std::size_t maxChunksInFlight = 0;
+        bool stopping = false;
+    };
+    // Chunks that may be parsed ahead of delivery per worker
+    static constexpr std::size_t kChunksInFlightPerThread = 2;
+    // ==========================
+    // PUBLIC TYPES AND CONSTANTS
+    // ==========================
+    // ========================
+    // PRIVATE STATIC VARIABLES
+    // ========================
+    // =======================
+    // PUBLIC STATIC VARIABLES
+    // =======================
+    // ===============
+    // PRIVATE METHODS
+    // ===============
+    /// <summary>
+    /// Parse the record on a line; only whitespace may follow its value.
+    /// </summary>
+    /// <param name="json">JSON object used to parse.</param>
+    /// <param name="line">Line holding record.</param>
+    /// <returns>Record JNode structure.</returns>
+    std::unique_ptr<JNode> NDJSONReader::parseLine(JSON &json, std::string_view line)
+    {
+        IndexedSource source(line);
+        std::unique_ptr<JNode> jNode = json.parseJNodes(source);
+        source.skipWhiteSpace();
+        if (source.bytesToParse())
+        {
+            throw JSON::SyntaxError();
+        }
+        return (jNode);
+    }
+    /// <summary>
+    /// Parse each line of a chunk into a record; blank lines are skipped.
+    /// </summary>
+    /// <param name="json">JSON object used to parse.</param>
+    /// <param name="chunk">Chunk of whole lines.</param>
+    /// <param name="chunkOffset">Offset of chunk in buffer.</param>
+    /// <param name="records">Parsed records.</param>
+    /// <returns></returns>
+    void NDJSONReader::parseChunk(JSON &json, std::string_view chunk, std::size_t chunkOffset, std::vector<Record> &records)
+    {
+        std::size_t lineStart = 0;
+        while (lineStart < chunk.size())
+        {
+            std::size_t lineEnd = chunk.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = chunk.size();
+            }
+            std::string_view line = chunk.substr(lineStart, lineEnd - lineStart);
+            if (line.find_first_not_of(" \t\r") != std::string_view::npos)
+            {
+                NDJSONReader::Record record;
+                record.offset = chunkOffset + lineStart;
+                try
+                {
+                    record.jNode = parseLine(json, line);
+                }
+                catch (std::exception &ex)
+                {
+                    record.error = ex.what();
+                }
+                records.push_back(std::move(record));
+            }
+            lineStart = lineEnd + 1;
+        }
+    }
+    /// <summary>
+    /// Worker thread; parses the next chunk whenever it is allowed to get
+    /// ahead of delivery until there are none left.
+    /// </summary>
+    /// <param name="settings">JSON object whose settings are used to parse.</param>
+    /// <param name="queue">Chunk queue.</param>
+    /// <param name="ordered">true if records are delivered in order.</param>
+    /// <returns></returns>
+    void NDJSONReader::parseChunks(const JSON &settings, ChunkQueue &queue, bool ordered)
+    {
+        JSON::WorkScope workScope(settings);
+        for (;;)
+        {
+            std::size_t chunk;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.workReady.wait(lock, [&queue]
+                                     { return (queue.stopping ||
+                                               (queue.nextChunk == queue.chunks.size()) ||
+                                               (queue.nextChunk < queue.deliveredChunks + queue.maxChunksInFlight)); });
+                if (queue.stopping || (queue.nextChunk == queue.chunks.size()))
+                {
+                    return;
+                }
+                chunk = queue.nextChunk++;
+            }
+            std::vector<NDJSONReader::Record> records;
+            parseChunk(workScope.json, queue.chunks[chunk], queue.chunks[chunk].data() - queue.chunks[0].data(), records);
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.results[chunk] = std::move(records);
+                queue.completed[chunk] = true;
+                if (!ordered)
+                {
+                    queue.completedOrder.push_back(chunk);
+                }
+            }
+            queue.resultReady.notify_one();
+        }
+    }
+    /// <summary>
+    /// Split a buffer into chunks of roughly the chunk size, each ending
+    /// just after a newline (or at the end of the buffer).
+    /// </summary>
+    /// <param name="ndjsonBuffer">Buffer of NDJSON.</param>
+    /// <returns>Chunks of buffer.</returns>
+    std::vector<std::string_view> NDJSONReader::splitIntoChunks(std::string_view ndjsonBuffer)
+    {
+        std::vector<std::string_view> chunks;
+        std::size_t chunkStart = 0;
+        while (chunkStart < ndjsonBuffer.size())
+        {
+            std::size_t chunkEnd = ndjsonBuffer.size();
+            if (ndjsonBuffer.size() - chunkStart > m_chunkSize)
+            {
+                const void *newline = std::memchr(ndjsonBuffer.data() + chunkStart + m_chunkSize, '\n',
+                                                  ndjsonBuffer.size() - chunkStart - m_chunkSize);
+                if (newline != nullptr)
+                {
+                    chunkEnd = static_cast<const char *>(newline) - ndjsonBuffer.data() + 1;
+                }
+            }
+            chunks.push_back(ndjsonBuffer.substr(chunkStart, chunkEnd - chunkStart));
+            chunkStart = chunkEnd;
+        }
+        return (chunks);
+    }
+    // ==============
+    // PUBLIC METHODS
+    // ==============
+    /// <summary>
+    /// NDJSONReader constructor; records are parsed with default settings.
+    /// </summary>
+    /// <param name="threadCount">Number of worker threads (0 for one per core).</param>
+    /// <param name="ordered">true if records are to be delivered in order.</param>
+    /// <param name="chunkSize">Approximate size of chunk parsed by a worker at a time.</param>
+    NDJSONReader::NDJSONReader(unsigned threadCount, bool ordered, std::size_t chunkSize)
+        : NDJSONReader(JSON(), threadCount, ordered, chunkSize)
+    {
+    }
+    /// <summary>
+    /// NDJSONReader constructor; records are parsed with the settings of a
+    /// JSON object (which is copied, so later changes to it do not apply).
+    /// </summary>
+    /// <param name="json">JSON object whose settings are used to parse.</param>
+    /// <param name="threadCount">Number of worker threads (0 for one per core).</param>
+    /// <param name="ordered">true if records are to be delivered in order.</param>
+    /// <param name="chunkSize">Approximate size of chunk parsed by a worker at a time.</param>
+    NDJSONReader::NDJSONReader(const JSON &json, unsigned threadCount, bool ordered, std::size_t chunkSize)
+        : m_json(json), m_threadCount(threadCount), m_ordered(ordered), m_chunkSize(chunkSize)
+    {
+        if (m_threadCount == 0)
+        {
+            m_threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        if (m_chunkSize == 0)
+        {
+            throw std::invalid_argument("NDJSON chunk size must be greater than zero.");
+        }
+    }
+    /// <summary>
+    /// Parse each record (line) in a buffer of NDJSON passing it to a
+    /// callback (on the calling thread). If the callback (or starting a
+    /// worker) throws then the workers are stopped and the exception rethrown.
+    /// </summary>
+    /// <param name="ndjsonBuffer">Buffer of NDJSON.</param>
+    /// <param name="callback">Called with each record.</param>
+    /// <returns>Number of records delivered.</returns>
+    std::size_t NDJSONReader::parseBuffer(std::string_view ndjsonBuffer, const RecordCallback &callback)
+    {
+        if (ndjsonBuffer.empty())
+        {
+            throw std::invalid_argument("Empty string passed to be parsed.");
+        }
+        ChunkQueue queue;
+        queue.chunks = splitIntoChunks(ndjsonBuffer);
+        queue.results.resize(queue.chunks.size());
+        queue.completed.resize(queue.chunks.size(), false);
+        queue.maxChunksInFlight = m_threadCount * kChunksInFlightPerThread;
+        std::vector<std::thread> workers;
+        std::size_t recordCount = 0;
+        try
+        {
+            for (unsigned worker = 0; worker < std::min<std::size_t>(m_threadCount, queue.chunks.size()); worker++)
+            {
+                workers.emplace_back(parseChunks, std::cref(m_json), std::ref(queue), m_ordered);
+            }
+            while (queue.deliveredChunks < queue.chunks.size())
+            {
+                std::vector<Record> records;
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    std::size_t chunk;
+                    if (m_ordered)
+                    {
+                        queue.resultReady.wait(lock, [&queue]
+                                               { return (queue.completed[queue.deliveredChunks]); });
+                        chunk = queue.deliveredChunks;
+                    }
+                    else
+                    {
+                        queue.resultReady.wait(lock, [&queue]
+                                               { return (!queue.completedOrder.empty()); });
+                        chunk = queue.completedOrder.front();
+                        queue.completedOrder.pop_front();
+                    }
+                    records = std::move(queue.results[chunk]);
+                }
+                for (auto &record : records)
+                {
+                    callback(record);
+                    recordCount++;
+                }
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    queue.deliveredChunks++;
+                }
+                queue.workReady.notify_all();
+            }
+        }
+        catch (...)
+        {
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.stopping = true;
+            }
+            queue.workReady.notify_all();
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            throw;
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        return (recordCount);
+    }
+    /// <summary>
+    /// Parse each record (line) in a file of NDJSON passing it to a
+    /// callback. The file is memory mapped (or read in whole).
+    /// </summary>
+    /// <param name="sourceFileName">NDJSON source file name.</param>
+    /// <param name="callback">Called with each record.</param>
+    /// <returns>Number of records delivered.</returns>
+    std::size_t NDJSONReader::parseFile(const std::string &sourceFileName, const RecordCallback &callback)
+    {
+        if (sourceFileName.empty())
+        {
+            throw std::invalid_argument("Empty file name passed to be parsed.");
+        }
+        MappedFileSource file(sourceFileName);
+        return (parseBuffer(file.remainingBytes(), callback));
+    }
+} // namespace H4
@@ -4,10 +4,21 @@
 // C++ STL
 //
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
 #include <list>
 #include <memory>
+#include <memory_resource>
+#include <charconv>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+//
+// JNodeObject entry map
+//
+#include "JNodeMap.hpp"
 // =========
 // NAMESPACE
 // =========
@@ -27,6 +38,14 @@ namespace H4
         null = 6
     };
     //
+    // Shared by the nodes of a lazily parsed buffer (JSON::parseBufferLazy())
+    // so that they can be parsed/decoded on first access; defined with the
+    // parser.
+    //
+    struct JNodeLazyContext;
+    // Native numeric value (defined below)
+    struct JNumeric;
+    //
     // Base JNode/
     //
     struct JNode
@@ -35,105 +54,417 @@ namespace H4
         JNode(JNodeType nodeType = JNodeType::base) : nodeType(nodeType)
         {
         }
-        JNode &operator[](std::string key);
+        JNode &operator[](std::string_view key);
         JNode &operator[](int index);
+        const JNode &operator[](std::string_view key) const;
+        const JNode &operator[](int index) const;
+        void freeze();
+        bool isFrozen() const
+        {
+            return (m_frozen);
+        }
         const JNodeType nodeType;
+        // Set for nodes placed in a JSONDocument arena; these are never
+        // deleted individually but released along with their document.
+        bool arenaOwned = false;
+
+    protected:
+        // Nodes in a JSONDocument arena are never deleted so a heap allocated
+        // child added to one would leak; it must come from the arena too
+        // (see JSONDocument::makeJNode()).
+        void checkArenaOwned(const JNode *child) const
+        {
+            if (arenaOwned && (child != nullptr) && !child->arenaOwned)
+            {
+                throw std::runtime_error("JNode added to a JSONDocument must be allocated from its arena.");
+            }
+        }
+        bool m_frozen = false;
+    };
+} // namespace H4
+// =========
+// NAMESPACE
+// =========
+namespace std
+{
+    //
+    // JNode has no virtual destructor so deletion through a base pointer
+    // is routed on node type here; arena owned nodes are left alone.
+    //
+    template <>
+    struct default_delete<H4::JNode>
+    {
+        constexpr default_delete() noexcept = default;
+        template <typename T, typename = std::enable_if_t<std::is_convertible_v<T *, H4::JNode *>>>
+        default_delete(const default_delete<T> &) noexcept
+        {
+        }
+        void operator()(H4::JNode *jNode) const;
     };
+} // namespace std
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
     //
     // Dictionary JNode.
     //
     struct JNodeObject : JNode
     {
     public:
-        JNodeObject() : JNode(JNodeType::object) {}
-        bool containsKey(const std::string &key)
+        JNodeObject(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : JNode(JNodeType::object), m_value(resource) {}
+        // Object whose entries are parsed from its JSON on first access
+        JNodeObject(std::string_view lazyJSON, std::shared_ptr<JNodeLazyContext> lazyContext)
+            : JNode(JNodeType::object), m_lazyJSON(lazyJSON), m_lazyContext(std::move(lazyContext)) {}
+        bool containsKey(std::string_view key) const
         {
-            return (m_value.count(key) > 0);
+            materialize();
+            return (m_value.find(key) != nullptr);
         }
-        int size()
+        int size() const
         {
+            materialize();
             return ((int)m_value.size());
         }
-        void addEntry(const std::string key, std::unique_ptr<JNode> entry)
+        void addEntry(std::string_view key, std::unique_ptr<JNode> entry)
+        {
+            if (m_frozen)
+            {
+                throw std::runtime_error("Frozen JNode cannot be modified.");
+            }
+            checkArenaOwned(entry.get());
+            materialize();
+            m_value.insert_or_assign(key, std::move(entry));
+        }
+        // Returns nullptr if the key is not present
+        JNode *getEntry(std::string_view key)
         {
-            m_value[key] = std::move(entry);
-            m_keys.push_back(key);
+            materialize();
+            std::unique_ptr<JNode> *entry = m_value.find(key);
+            return ((entry != nullptr) ? entry->get() : nullptr);
         }
-        JNode *getEntry(const std::string &key)
+        const JNode *getEntry(std::string_view key) const
         {
-            return (m_value[key].get());
+            materialize();
+            const std::unique_ptr<JNode> *entry = m_value.find(key);
+            return ((entry != nullptr) ? entry->get() : nullptr);
         }
-        std::vector<std::string> &getKeys()
+        std::vector<std::string_view> getKeys() const
         {
-            return (m_keys);
+            materialize();
+            std::vector<std::string_view> keys;
+            keys.reserve(m_value.size());
+            for (auto &entry : m_value)
+            {
+                keys.push_back(entry.key);
+            }
+            return (keys);
+        }
+        // Key/value entries in the order they were added
+        JNodeMap<std::unique_ptr<JNode>> &getEntries()
+        {
+            materialize();
+            return (m_value);
+        }
+        const JNodeMap<std::unique_ptr<JNode>> &getEntries() const
+        {
+            materialize();
+            return (m_value);
         }
 
     protected:
-        std::map<std::string, std::unique_ptr<JNode>> m_value;
-        // Note: Store keys so when write away keep key order
-        // that they have had in the source form be it file/network/buffer.
-        std::vector<std::string> m_keys;
+        // A lazily parsed object is parsed on first access even through a
+        // const reference; it is only logically const until then (and JNodes
+        // are never created const).
+        void materialize() const
+        {
+            if (m_lazyContext != nullptr)
+            {
+                const_cast<JNodeObject *>(this)->parseLazyJSON();
+            }
+        }
+        void parseLazyJSON();
+        friend struct std::default_delete<JNode>;
+        // Note: Entries are kept in the order they were added so when
+        // written away keys keep the order that they had in the source
+        // form be it file/network/buffer.
+        JNodeMap<std::unique_ptr<JNode>> m_value;
+        std::string_view m_lazyJSON;
+        std::shared_ptr<JNodeLazyContext> m_lazyContext;
     };
     //
-    // List JNode.
+    // List JNode. If asked to (JSON::packNumbers()) the parser packs an
+    // array whose elements are all numbers (integers within +-2^53 or
+    // finite floating point) into one contiguous vector of doubles, plus a
+    // bit per element marking the integers, instead of a JNodeNumber per
+    // element. Packed numbers are read with packedSize(), getPackedNumbers()
+    // and getPackedNumeric(), which never change the array. The first
+    // non-const access to the elements themselves (getArray(), getEntry(),
+    // operator[] or addEntry()) unpacks them into JNodeNumbers; const
+    // element access to a packed array throws instead, so reading through
+    // const references (or from several threads) never unpacks it. A
+    // frozen array stays packed and its elements can then only be read
+    // with the packed accessors. Lazily parsed arrays are never packed, as
+    // they are only parsed when their elements are accessed.
     //
     struct JNodeArray : JNode
     {
     public:
-        JNodeArray() : JNode(JNodeType::array) {}
-        int size()
+        // Largest magnitude of integer that is packed (exact as a double)
+        static constexpr long long kMaxPackedInteger = 1LL << 53;
+        JNodeArray(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : JNode(JNodeType::array), m_value(resource), m_packed(resource), m_packedIntegers(resource) {}
+        // Array whose elements are parsed from its JSON on first access
+        JNodeArray(std::string_view lazyJSON, std::shared_ptr<JNodeLazyContext> lazyContext)
+            : JNode(JNodeType::array), m_lazyJSON(lazyJSON), m_lazyContext(std::move(lazyContext)) {}
+        int size() const
         {
+            if (isPacked())
+            {
+                return ((int)m_packed.size());
+            }
+            materialize();
             return ((int)m_value.size());
         }
+        bool isPacked() const
+        {
+            return (!m_packed.empty());
+        }
+        std::size_t packedSize() const
+        {
+            return (m_packed.size());
+        }
+        const std::pmr::vector<double> &getPackedNumbers() const
+        {
+            if (!isPacked())
+            {
+                throw std::runtime_error("JNodeArray is not packed.");
+            }
+            return (m_packed);
+        }
+        JNumeric getPackedNumeric(std::size_t index) const;
+        static bool isPackable(const JNumeric &numeric);
+        bool packNumber(const JNumeric &numeric);
         void addEntry(std::unique_ptr<JNode> jNode)
         {
+            if (m_frozen)
+            {
+                throw std::runtime_error("Frozen JNode cannot be modified.");
+            }
+            checkArenaOwned(jNode.get());
+            materialize();
             m_value.push_back(std::move(jNode));
         }
-        std::vector<std::unique_ptr<JNode>> &getArray()
+        std::pmr::vector<std::unique_ptr<JNode>> &getArray()
         {
+            materialize();
+            return (m_value);
+        }
+        const std::pmr::vector<std::unique_ptr<JNode>> &getArray() const
+        {
+            materialize();
             return (m_value);
         }
         JNode *getEntry(int index)
         {
+            materialize();
+            return (m_value[index].get());
+        }
+        const JNode *getEntry(int index) const
+        {
+            materialize();
             return (m_value[index].get());
         }
 
     protected:
-        std::vector<std::unique_ptr<JNode>> m_value;
+        // Parsed on first access even through a const reference; packed
+        // numbers are only unpacked by non-const access to an array that is
+        // not frozen.
+        void materialize() const
+        {
+            if (m_lazyContext != nullptr)
+            {
+                const_cast<JNodeArray *>(this)->parseLazyJSON();
+            }
+            else if (isPacked())
+            {
+                throw std::runtime_error("Packed JNodeArray elements must be read with getPackedNumeric().");
+            }
+        }
+        void materialize()
+        {
+            if (isPacked() && !m_frozen)
+            {
+                unpackNumbers();
+            }
+            static_cast<const JNodeArray *>(this)->materialize();
+        }
+        void parseLazyJSON();
+        void unpackNumbers();
+        friend struct std::default_delete<JNode>;
+        std::pmr::vector<std::unique_ptr<JNode>> m_value;
+        std::pmr::vector<double> m_packed;
+        std::pmr::vector<bool> m_packedIntegers;
+        std::string_view m_lazyJSON;
+        std::shared_ptr<JNodeLazyContext> m_lazyContext;
     };
     //
-    // Number JNode.
+    // Numeric value held natively (signed/unsigned 64 bit integer or
+    // double) so that it is converted from text only once.
+    //
+    struct JNumeric
+    {
+    public:
+        enum class Kind : std::uint8_t
+        {
+            integer = 0,
+            unsignedInteger = 1,
+            floatingPoint = 2
+        };
+        Kind kind = Kind::integer;
+        union
+        {
+            long long integer = 0;
+            unsigned long long unsignedInteger;
+            double floatingPoint;
+        };
+        // Convert JSON number text; integers too large for a long long
+        // become unsigned and then floating point. Returns false if the
+        // text was not all used.
+        static bool fromText(std::string_view text, JNumeric &numeric)
+        {
+            const char *first = text.data();
+            const char *last = text.data() + text.size();
+            if (text.find_first_of(".eE") == std::string_view::npos)
+            {
+                numeric.kind = Kind::integer;
+                std::from_chars_result result = std::from_chars(first, last, numeric.integer);
+                if (result.ec == std::errc())
+                {
+                    return (result.ptr == last);
+                }
+                if ((result.ec == std::errc::result_out_of_range) && (text[0] != '-'))
+                {
+                    numeric.kind = Kind::unsignedInteger;
+                    result = std::from_chars(first, last, numeric.unsignedInteger);
+                    if (result.ec == std::errc())
+                    {
+                        return (result.ptr == last);
+                    }
+                }
+            }
+            numeric.kind = Kind::floatingPoint;
+            std::from_chars_result result = std::from_chars(first, last, numeric.floatingPoint);
+            if (result.ec == std::errc::result_out_of_range)
+            {
+                // Overflow/underflow gives +-HUGE_VAL/0.0 as strtod does
+                numeric.floatingPoint = std::strtod(std::string(text).c_str(), nullptr);
+                return (true);
+            }
+            return ((result.ec == std::errc()) && (result.ptr == last));
+        }
+        // Longest text form written by toChars()
+        static constexpr std::size_t kMaxTextLength = 32;
+        // Write shortest text form that converts back to the same value
+        // to buffer (of at least kMaxTextLength) returning its end
+        char *toChars(char *buffer) const
+        {
+            switch (kind)
+            {
+            case Kind::integer:
+                return (std::to_chars(buffer, buffer + kMaxTextLength, integer).ptr);
+            case Kind::unsignedInteger:
+                return (std::to_chars(buffer, buffer + kMaxTextLength, unsignedInteger).ptr);
+            default:
+                return (std::to_chars(buffer, buffer + kMaxTextLength, floatingPoint).ptr);
+            }
+        }
+        std::string toString() const
+        {
+            char buffer[kMaxTextLength];
+            return (std::string(buffer, toChars(buffer)));
+        }
+        // Returns true only if the number is an integer that fits in a long
+        bool getInteger(long &longValue) const
+        {
+            switch (kind)
+            {
+            case Kind::integer:
+                longValue = (long)integer;
+                return ((integer >= LONG_MIN) && (integer <= LONG_MAX));
+            case Kind::unsignedInteger:
+                longValue = (long)unsignedInteger;
+                return (unsignedInteger <= (unsigned long long)LONG_MAX);
+            default:
+                longValue = ((floatingPoint >= (double)LONG_MIN) && (floatingPoint < (double)LONG_MAX)) ? (long)floatingPoint : 0;
+                return (false);
+            }
+        }
+        bool getFloatingPoint(double &doubleValue) const
+        {
+            switch (kind)
+            {
+            case Kind::integer:
+                doubleValue = (double)integer;
+                break;
+            case Kind::unsignedInteger:
+                doubleValue = (double)unsignedInteger;
+                break;
+            default:
+                doubleValue = floatingPoint;
+                break;
+            }
+            return (true);
+        }
+    };
+    //
+    // Number JNode. The value is held as a JNumeric; the original text is
+    // only kept if asked for (or the node was created from text) and is
+    // then what is returned by getNumber() and written on stringify.
     //
     struct JNodeNumber : JNode
     {
     public:
-        JNodeNumber(const std::string &value) : JNode(JNodeType::number)
+        JNodeNumber(const JNumeric &numeric, std::string_view text = std::string_view(), std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : JNode(JNodeType::number), m_numeric(numeric), m_text(text, resource)
         {
-            this->m_value = value;
+        }
+        JNodeNumber(std::string_view text, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : JNode(JNodeType::number), m_text(text, resource)
+        {
+            JNumeric::fromText(text, m_numeric);
         }
         // Convert to long returning true on success
         // Note: Can still return a long value for floating point
         // but false as the number is not in integer format
-        bool getInteger(long &longValue)
+        bool getInteger(long &longValue) const
         {
-            char *end;
-            longValue = std::strtoll(m_value.c_str(), &end, 10);
-            return (*end == '\0'); // If not all characters used then not success
+            return (m_numeric.getInteger(longValue));
         }
         // Convert to double returning true on success
-        bool getFloatingPoint(double &doubleValue)
+        bool getFloatingPoint(double &doubleValue) const
         {
-            char *end;
-            doubleValue = std::strtod(m_value.c_str(), &end);
-            return (*end == '\0'); // If not all characters used then not success
+            return (m_numeric.getFloatingPoint(doubleValue));
         }
-        std::string &getNumber()
+        const JNumeric &getNumeric() const
         {
-            return (m_value);
+            return (m_numeric);
+        }
+        // Original text of number (empty if not kept)
+        std::string_view getText() const
+        {
+            return (m_text);
+        }
+        std::string getNumber() const
+        {
+            return (m_text.empty() ? m_numeric.toString() : std::string(m_text));
         }
 
     protected:
-        std::string m_value;
+        JNumeric m_numeric;
+        std::pmr::string m_text;
     };
     //
     // String JNode.
@@ -141,17 +472,37 @@ namespace H4
     struct JNodeString : JNode
     {
     public:
-        JNodeString(const std::string &value) : JNode(JNodeType::string)
+        JNodeString(std::string_view value, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : JNode(JNodeType::string), m_value(value, resource)
         {
-            this->m_value = value;
         }
-        std::string &getString()
+        // String whose escape sequences are decoded on first access
+        JNodeString(std::string_view escapedValue, std::shared_ptr<JNodeLazyContext> lazyContext)
+            : JNode(JNodeType::string), m_value(escapedValue), m_lazyContext(std::move(lazyContext))
         {
+        }
+        std::pmr::string &getString()
+        {
+            if (m_lazyContext != nullptr)
+            {
+                decodeLazyJSON();
+            }
+            return (m_value);
+        }
+        // Decoded on first access even through a const reference
+        const std::pmr::string &getString() const
+        {
+            if (m_lazyContext != nullptr)
+            {
+                const_cast<JNodeString *>(this)->decodeLazyJSON();
+            }
             return (m_value);
         }
 
     protected:
-        std::string m_value;
+        void decodeLazyJSON();
+        std::pmr::string m_value;
+        std::shared_ptr<JNodeLazyContext> m_lazyContext;
     };
     //
     // Boolean JNode.
@@ -163,7 +514,7 @@ namespace H4
         {
             this->m_value = value;
         }
-        bool getBoolean()
+        bool getBoolean() const
         {
             return (m_value);
         }
@@ -180,7 +531,7 @@ namespace H4
         JNodeNull() : JNode(JNodeType::null)
         {
         }
-        void *getNull()
+        void *getNull() const
         {
             return (nullptr);
         }
@@ -193,16 +544,87 @@ namespace H4
     {
         return (static_cast<T &>(jNode));
     }
+    template <typename T>
+    const T &JNodeRef(const JNode &jNode)
+    {
+        return (static_cast<const T &>(jNode));
+    }
+    //
+    // Packed numeric arrays
+    //
+    inline JNumeric JNodeArray::getPackedNumeric(std::size_t index) const
+    {
+        JNumeric numeric;
+        if (m_packedIntegers[index])
+        {
+            numeric.kind = JNumeric::Kind::integer;
+            numeric.integer = (long long)m_packed[index];
+        }
+        else
+        {
+            numeric.kind = JNumeric::Kind::floatingPoint;
+            numeric.floatingPoint = m_packed[index];
+        }
+        return (numeric);
+    }
+    // Number is an integer within +-2^53 or finite floating point
+    inline bool JNodeArray::isPackable(const JNumeric &numeric)
+    {
+        if (numeric.kind == JNumeric::Kind::integer)
+        {
+            return ((numeric.integer >= -kMaxPackedInteger) && (numeric.integer <= kMaxPackedInteger));
+        }
+        return ((numeric.kind == JNumeric::Kind::floatingPoint) && std::isfinite(numeric.floatingPoint));
+    }
+    // Add a number to the packed numbers of an array returning false (and
+    // leaving the array as is) if it cannot be; only an array without any
+    // JNode elements is packed.
+    inline bool JNodeArray::packNumber(const JNumeric &numeric)
+    {
+        if (!isPackable(numeric) || m_frozen || (m_lazyContext != nullptr) || !m_value.empty())
+        {
+            return (false);
+        }
+        bool integer = (numeric.kind == JNumeric::Kind::integer);
+        m_packed.push_back(integer ? (double)numeric.integer : numeric.floatingPoint);
+        m_packedIntegers.push_back(integer);
+        return (true);
+    }
+    // Replace packed numbers with a JNodeNumber for each (allocated from the
+    // same arena as the array if it has one)
+    inline void JNodeArray::unpackNumbers()
+    {
+        std::pmr::memory_resource *arena = arenaOwned ? m_value.get_allocator().resource() : nullptr;
+        m_value.reserve(m_value.size() + m_packed.size());
+        for (std::size_t index = 0; index < m_packed.size(); index++)
+        {
+            if (arena == nullptr)
+            {
+                m_value.push_back(std::make_unique<JNodeNumber>(getPackedNumeric(index)));
+            }
+            else
+            {
+                JNodeNumber *jNode = new (arena->allocate(sizeof(JNodeNumber), alignof(JNodeNumber))) JNodeNumber(getPackedNumeric(index), std::string_view(), arena);
+                jNode->arenaOwned = true;
+                m_value.push_back(std::unique_ptr<JNode>(jNode));
+            }
+        }
+        m_packed.clear();
+        m_packed.shrink_to_fit();
+        m_packedIntegers.clear();
+        m_packedIntegers.shrink_to_fit();
+    }
     //
     // Index overloads
     //
-    inline JNode &JNode::operator[](std::string key) // Object
+    inline JNode &JNode::operator[](std::string_view key) // Object
     {
         if (nodeType == JNodeType::object)
         {
-            if (JNodeRef<JNodeObject>(*this).containsKey(key))
+            JNode *entry = JNodeRef<JNodeObject>(*this).getEntry(key);
+            if (entry != nullptr)
             {
-                return (*(JNodeRef<JNodeObject>(*this).getEntry(key)));
+                return (*entry);
             }
         }
         throw std::runtime_error("Invalid key used to access object.");
@@ -218,6 +640,135 @@ namespace H4
         }
         throw std::runtime_error("Invalid index used to access array.");
     }
-
+    inline const JNode &JNode::operator[](std::string_view key) const // Object
+    {
+        if (nodeType == JNodeType::object)
+        {
+            const JNode *entry = JNodeRef<JNodeObject>(*this).getEntry(key);
+            if (entry != nullptr)
+            {
+                return (*entry);
+            }
+        }
+        throw std::runtime_error("Invalid key used to access object.");
+    }
+    inline const JNode &JNode::operator[](int index) const // Array
+    {
+        if (nodeType == JNodeType::array)
+        {
+            if ((index >= 0) && (index < JNodeRef<JNodeArray>(*this).size()))
+            {
+                return (*(JNodeRef<JNodeArray>(*this).getEntry(index)));
+            }
+        }
+        throw std::runtime_error("Invalid index used to access array.");
+    }
+    //
+    // Freeze a JNode structure. Any lazily parsed objects/arrays in it are
+    // parsed and strings decoded so that reading it through const
+    // references (which never insert or cache anything) changes nothing;
+    // a frozen structure may then be read by any number of threads at once
+    // without locking. Packed numeric arrays are left packed (their
+    // elements are read with JNodeArray::getPackedNumeric()). Adding
+    // entries to a frozen
+    // object/array throws; the non-const accessors still give direct access
+    // so must not be used to change a frozen structure.
+    //
+    inline void JNode::freeze()
+    {
+        std::vector<JNode *> jNodes{this};
+        while (!jNodes.empty())
+        {
+            JNode *jNode = jNodes.back();
+            jNodes.pop_back();
+            if ((jNode == nullptr) || jNode->m_frozen)
+            {
+                continue;
+            }
+            switch (jNode->nodeType)
+            {
+            case JNodeType::object:
+                for (auto &entry : JNodeRef<JNodeObject>(*jNode).getEntries())
+                {
+                    jNodes.push_back(entry.value.get());
+                }
+                break;
+            case JNodeType::array:
+                if (JNodeRef<JNodeArray>(*jNode).isPacked())
+                {
+                    break;
+                }
+                for (auto &element : JNodeRef<JNodeArray>(*jNode).getArray())
+                {
+                    jNodes.push_back(element.get());
+                }
+                break;
+            case JNodeType::string:
+                JNodeRef<JNodeString>(*jNode).getString();
+                break;
+            default:
+                break;
+            }
+            jNode->m_frozen = true;
+        }
+    }
 } // namespace H4
+//
+// JNode deletion. Any objects/arrays nested in the node being deleted are
+// taken from their parent and deleted in turn from a work list so that a
+// deeply nested structure is freed without recursing once per level.
+//
+inline void std::default_delete<H4::JNode>::operator()(H4::JNode *jNode) const
+{
+    std::vector<H4::JNode *> containers;
+    for (;;)
+    {
+        if (!jNode->arenaOwned)
+        {
+            switch (jNode->nodeType)
+            {
+            case H4::JNodeType::object:
+                for (auto &entry : static_cast<H4::JNodeObject *>(jNode)->m_value)
+                {
+                    if ((entry.value != nullptr) && ((entry.value->nodeType == H4::JNodeType::object) || (entry.value->nodeType == H4::JNodeType::array)))
+                    {
+                        containers.push_back(entry.value.release());
+                    }
+                }
+                delete static_cast<H4::JNodeObject *>(jNode);
+                break;
+            case H4::JNodeType::array:
+                for (auto &element : static_cast<H4::JNodeArray *>(jNode)->m_value)
+                {
+                    if ((element != nullptr) && ((element->nodeType == H4::JNodeType::object) || (element->nodeType == H4::JNodeType::array)))
+                    {
+                        containers.push_back(element.release());
+                    }
+                }
+                delete static_cast<H4::JNodeArray *>(jNode);
+                break;
+            case H4::JNodeType::number:
+                delete static_cast<H4::JNodeNumber *>(jNode);
+                break;
+            case H4::JNodeType::string:
+                delete static_cast<H4::JNodeString *>(jNode);
+                break;
+            case H4::JNodeType::boolean:
+                delete static_cast<H4::JNodeBoolean *>(jNode);
+                break;
+            case H4::JNodeType::null:
+                delete static_cast<H4::JNodeNull *>(jNode);
+                break;
+            default:
+                delete jNode;
+            }
+        }
+        if (containers.empty())
+        {
+            return;
+        }
+        jNode = containers.back();
+        containers.pop_back();
+    }
+}
 #endif /* JNODE_HPP */
\ No newline at end of file
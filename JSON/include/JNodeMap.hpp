@@ -0,0 +1,164 @@
+#ifndef JNODEMAP_HPP
+#define JNODEMAP_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory_resource>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    //
+    // Insertion ordered map of string keys to values used for JNodeObject
+    // entries. Each key is stored once, next to its value, in a vector kept
+    // in insertion order (which is the order written out on stringify). Once
+    // there are more than a handful of entries an open addressing (linear
+    // probe) index of entry numbers is maintained alongside for lookups;
+    // small objects are just searched linearly. Lookups take a string_view
+    // so no temporary key strings are created.
+    //
+    template <typename T>
+    class JNodeMap
+    {
+    public:
+        struct Entry
+        {
+            std::pmr::string key;
+            T value;
+        };
+        JNodeMap(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : m_entries(resource), m_slots(resource)
+        {
+        }
+        std::size_t size() const
+        {
+            return (m_entries.size());
+        }
+        T *find(std::string_view key)
+        {
+            std::size_t index = findIndex(key);
+            return ((index != kNotFound) ? &m_entries[index].value : nullptr);
+        }
+        const T *find(std::string_view key) const
+        {
+            std::size_t index = findIndex(key);
+            return ((index != kNotFound) ? &m_entries[index].value : nullptr);
+        }
+        // Add a new entry or replace the value of an existing one (which
+        // keeps its original position).
+        T &insert_or_assign(std::string_view key, T value)
+        {
+            std::size_t index = findIndex(key);
+            if (index != kNotFound)
+            {
+                m_entries[index].value = std::move(value);
+                return (m_entries[index].value);
+            }
+            if (m_entries.size() >= UINT32_MAX)
+            {
+                throw std::length_error("Too many entries for JNodeObject.");
+            }
+            m_entries.push_back(Entry{std::pmr::string(key, m_entries.get_allocator().resource()), std::move(value)});
+            if (m_entries.size() > kLinearSearchLimit)
+            {
+                if (m_entries.size() * 2 > m_slots.size())
+                {
+                    rehash(std::max(m_slots.size() * 2, kMinimumSlots));
+                }
+                else
+                {
+                    addSlot(m_entries.size() - 1, hashKey(key));
+                }
+            }
+            return (m_entries.back().value);
+        }
+        void reserve(std::size_t count)
+        {
+            m_entries.reserve(count);
+        }
+        typename std::pmr::vector<Entry>::iterator begin()
+        {
+            return (m_entries.begin());
+        }
+        typename std::pmr::vector<Entry>::iterator end()
+        {
+            return (m_entries.end());
+        }
+        typename std::pmr::vector<Entry>::const_iterator begin() const
+        {
+            return (m_entries.begin());
+        }
+        typename std::pmr::vector<Entry>::const_iterator end() const
+        {
+            return (m_entries.end());
+        }
+
+    private:
+        // Slot in index; entry is the entry number plus one (zero is empty)
+        struct Slot
+        {
+            std::uint32_t entry;
+            std::uint32_t hash;
+        };
+        static constexpr std::size_t kNotFound = (std::size_t)-1;
+        static constexpr std::size_t kLinearSearchLimit = 8;
+        static constexpr std::size_t kMinimumSlots = 32;
+        static std::size_t hashKey(std::string_view key)
+        {
+            return (std::hash<std::string_view>{}(key));
+        }
+        std::size_t findIndex(std::string_view key) const
+        {
+            if (m_slots.empty())
+            {
+                for (std::size_t index = 0; index < m_entries.size(); index++)
+                {
+                    if (m_entries[index].key == key)
+                    {
+                        return (index);
+                    }
+                }
+                return (kNotFound);
+            }
+            std::size_t hash = hashKey(key);
+            std::size_t mask = m_slots.size() - 1;
+            for (std::size_t slot = hash & mask; m_slots[slot].entry != 0; slot = (slot + 1) & mask)
+            {
+                if ((m_slots[slot].hash == (std::uint32_t)hash) && (m_entries[m_slots[slot].entry - 1].key == key))
+                {
+                    return (m_slots[slot].entry - 1);
+                }
+            }
+            return (kNotFound);
+        }
+        void addSlot(std::size_t index, std::size_t hash)
+        {
+            std::size_t mask = m_slots.size() - 1;
+            std::size_t slot = hash & mask;
+            while (m_slots[slot].entry != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+            m_slots[slot] = Slot{(std::uint32_t)(index + 1), (std::uint32_t)hash};
+        }
+        void rehash(std::size_t slotCount)
+        {
+            m_slots.assign(slotCount, Slot{0, 0});
+            for (std::size_t index = 0; index < m_entries.size(); index++)
+            {
+                addSlot(index, hashKey(m_entries[index].key));
+            }
+        }
+        std::pmr::vector<Entry> m_entries;
+        std::pmr::vector<Slot> m_slots;
+    };
+} // namespace H4
+#endif /* JNODEMAP_HPP */
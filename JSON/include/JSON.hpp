@@ -4,6 +4,7 @@
 // C++ STL
 //
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
 #include <list>
@@ -17,11 +18,17 @@
 // JSON JNodes
 //
 #include "JNode.hpp"
+#include "JSONDocument.hpp"
+#include "JValue.hpp"
+#include "JSONTape.hpp"
+#include "JSONColumns.hpp"
 // =========
 // NAMESPACE
 // =========
 namespace H4
 {
+    class SpanSource;
+    class IndexedSource;
     // ================
     // CLASS DEFINITION
     // ================
@@ -32,7 +39,8 @@ namespace H4
         // PUBLIC TYPES AND CONSTANTS
         // ==========================
         //
-        // JSON syntax error.
+        // JSON syntax error; what() gives the error message if there is one
+        // (such as the nesting depth limit being exceeded).
         //
         struct SyntaxError : public std::exception
         {
@@ -40,7 +48,7 @@ namespace H4
             SyntaxError(const std::string &errorMessage="") : errorMessage(errorMessage) {}
             virtual const char *what() const throw()
             {
-                return ("JSON syntax error detected.");
+                return (errorMessage.empty() ? "JSON syntax error detected." : errorMessage.c_str());
             }
         private:
             std::string errorMessage;
@@ -51,8 +59,18 @@ namespace H4
         class ITranslator
         {
         public:
-            virtual std::string fromEscapeSequences(const std::string &jsonString) = 0;
-            virtual std::string toEscapeSequences(const std::string &utf8String) = 0;
+            // Strings are returned as views to avoid a copy per string. A
+            // returned view only needs to remain valid until the next call
+            // on the same thread (and may be the passed in string if there is
+            // nothing to do), so a translator can keep its result in storage
+            // that it reuses (JSONTranslator uses thread_local buffers shared
+            // by every JSON object on the thread). Anything holding on to a
+            // translated string must copy it before the next translation;
+            // the parsers, JSONReader and JSONPushParser all do. A translator
+            // used by a JSON object that is shared between threads must be
+            // safe to call concurrently.
+            virtual std::string_view fromEscapeSequences(std::string_view jsonString) = 0;
+            virtual std::string_view toEscapeSequences(std::string_view utf8String) = 0;
         protected:
             bool isValidSurrogateUpper(char16_t c)
             {
@@ -74,59 +92,246 @@ namespace H4
             virtual bool bytesToParse() = 0;
         };
         //
-        // Destination interface
+        // Destination interface; a destination need only implement
+        // addBytes(), addByte() can be overridden for speed.
         //
         class IDestination
         {
         public:
-            virtual void addBytes(std::string bytes) = 0;
+            virtual void addByte(char byte)
+            {
+                addBytes(std::string_view(&byte, 1));
+            }
+            virtual void addBytes(std::string_view bytes) = 0;
+        };
+        //
+        // Event handler interface for parses that do not build a JNode
+        // tree. Events are raised in document order; strings, keys and
+        // number text passed are only valid for the duration of the call
+        // (they may be views of the translator's buffer, which the next
+        // translation on the thread overwrites) so must be copied to be
+        // kept. All events default to doing nothing.
+        //
+        class IHandler
+        {
+        public:
+            virtual void onObjectStart() {}
+            virtual void onObjectEnd() {}
+            virtual void onArrayStart() {}
+            virtual void onArrayEnd() {}
+            virtual void onKey(std::string_view /*key*/) {}
+            virtual void onString(std::string_view /*string*/) {}
+            virtual void onNumber(const JNumeric &/*numeric*/, std::string_view /*text*/) {}
+            virtual void onBoolean(bool /*boolean*/) {}
+            virtual void onNull() {}
         };
+        // Default limit on object/array nesting when parsing
+        static constexpr std::size_t kDefaultMaxNestingDepth = 10000;
         // ============
         // CONSTRUCTORS
         // ============
         JSON(ITranslator *translator = nullptr);
+        JSON(const JSON &other);
         // ==========
         // DESTRUCTOR
         // ==========
         // ==============
         // PUBLIC METHODS
         // ==============
-        std::unique_ptr<JNode> parseBuffer(const std::string &jsonBuffer);
+        std::unique_ptr<JNode> parseBuffer(std::string_view jsonBuffer);
         std::unique_ptr<JNode> parseFile(const std::string &sourceFileName);
         std::string stringifyToBuffer(std::unique_ptr<JNode> jNodeRoot);
         void stringifyToFile(std::unique_ptr<JNode> jNodeRoot, const std::string &destinationFileName);
-        std::string stripWhiteSpaceBuffer(const std::string &jsonBuffer);
+        std::string stripWhiteSpaceBuffer(std::string_view jsonBuffer);
         std::unique_ptr<JNode> parse(ISource &source);
+        void parse(ISource &source, IHandler &handler);
+        void parseBuffer(std::string_view jsonBuffer, IHandler &handler);
+        void parseFile(const std::string &sourceFileName, IHandler &handler);
         void stringify(std::unique_ptr<JNode> jNodeRoot, IDestination &destination);
+        std::string stringifyToBuffer(const JNode &jNodeRoot);
+        void stringifyToFile(const JNode &jNodeRoot, const std::string &destinationFileName);
+        void stringify(const JNode &jNodeRoot, IDestination &destination);
+        JSONDocument parseBufferToDocument(std::string_view jsonBuffer);
+        JSONDocument parseFileToDocument(const std::string &sourceFileName);
+        std::string stringifyToBuffer(const JSONDocument &document);
+        void stringifyToFile(const JSONDocument &document, const std::string &destinationFileName);
+        JValueDocument parseBufferToJValues(std::string_view jsonBuffer);
+        JValueDocument parseFileToJValues(const std::string &sourceFileName);
+        std::string stringifyToBuffer(const JValueDocument &document);
+        std::string stringifyToBuffer(const JSONTape &tape);
+        void stringifyToFile(const JSONTape &tape, const std::string &destinationFileName);
+        void keepNumberText(bool keepNumberText);
+        void packNumbers(bool packNumbers);
+        void maxNestingDepth(std::size_t maxNestingDepth);
+        std::unique_ptr<JNode> parseBufferLazy(std::string_view jsonBuffer);
+        std::unique_ptr<JNode> parseFileLazy(const std::string &sourceFileName);
+        std::unique_ptr<JNode> parseBufferParallel(std::string_view jsonBuffer, unsigned threadCount = 0);
+        std::unique_ptr<JNode> parseFileParallel(const std::string &sourceFileName, unsigned threadCount = 0);
+        std::unique_ptr<JNode> extract(ISource &source, std::string_view pointer);
+        std::vector<std::unique_ptr<JNode>> extract(ISource &source, const std::vector<std::string> &pointers);
+        std::vector<std::unique_ptr<JNode>> extractFromBuffer(std::string_view jsonBuffer, const std::vector<std::string> &pointers);
+        std::vector<std::unique_ptr<JNode>> extractFromFile(const std::string &sourceFileName, const std::vector<std::string> &pointers);
+        std::vector<JSONColumn> extractColumns(const JNode &jNodeArray, const std::vector<JSONColumn::Field> &fields, unsigned threadCount = 1);
+        std::vector<JSONColumn> extractColumnsFromBuffer(std::string_view jsonBuffer, const std::vector<JSONColumn::Field> &fields, unsigned threadCount = 1);
+        std::vector<JSONColumn> extractColumnsFromFile(const std::string &sourceFileName, const std::vector<JSONColumn::Field> &fields, unsigned threadCount = 1);
         // ================
         // PUBLIC VARIABLES
         // ================
     private:
+        // Pull reader shares the token extract methods
+        friend class JSONReader;
+        friend class JSONPushParser;
+        // NDJSON records are parsed from an IndexedSource per line
+        friend class NDJSONReader;
+        // Lazily parsed nodes are parsed/decoded with the same methods
+        friend struct JNodeLazyContext;
         // ===========================
         // PRIVATE TYPES AND CONSTANTS
         // ===========================
+        //
+        // Parsed JSON Pointer (RFC 6901) and where its value is returned.
+        //
+        struct JSONPointer
+        {
+            std::vector<std::string> referenceTokens;
+            std::size_t result;
+            mutable bool resolved;
+        };
+        //
+        // Open object/array on the explicit stack used to parse without
+        // recursing once per level of nesting.
+        //
+        struct JNodeFrame
+        {
+            JNodeType nodeType;
+            JNode *jNode;
+            std::size_t firstJValue;
+        };
+        //
+        // Object/array (JNode or JValue) being written and its next entry
+        // on the explicit stack used to stringify.
+        //
+        struct StringifyFrame
+        {
+            const JNode *jNode;
+            const JValue *jValue;
+            std::size_t next;
+        };
+        //
+        // Work buffer and stacks kept for each thread between calls, so the
+        // copy a public method runs on reuses their capacity rather than
+        // allocating them again.
+        //
+        struct WorkScope;
+        struct WorkState
+        {
+            std::string workBuffer;
+            std::vector<JValue> jValueStack;
+            std::vector<JNodeFrame> jNodeStack;
+            std::vector<StringifyFrame> stringifyStack;
+        };
         // ===========================================
         // DISABLED CONSTRUCTORS/DESTRUCTORS/OPERATORS
         // ===========================================
+        JSON &operator=(const JSON &other) = delete;
         // ===============
         // PRIVATE METHODS
         // ===============
-        void ignoreWhiteSpace(ISource &source);
-        std::string extractString(ISource &source);
-        std::unique_ptr<JNode> parseJNodes(ISource &source);
-        std::unique_ptr<JNode> parseString(ISource &source);
-        std::unique_ptr<JNode> parseNumber(ISource &source);
-        std::unique_ptr<JNode> parseBoolean(ISource &source);
-        std::unique_ptr<JNode> parseNull(ISource &source);
-        std::unique_ptr<JNode> parseObject(ISource &source);
-        std::unique_ptr<JNode> parseArray(ISource &source);
-        void stringifyJNodes(JNode *jNode, IDestination &destination);
-        void stripWhiteSpace(ISource &source, IDestination &destination);
+        // Parse methods are templated on the source type so that contiguous
+        // buffers (SpanSource) are parsed without any virtual calls per byte;
+        // ISource is still accepted for custom sources. IndexedSource has its
+        // own whitespace/string overloads that use its structural index.
+        template <typename T, typename... Args>
+        std::unique_ptr<JNode> makeJNode(Args &&...args);
+        template <typename T>
+        void ignoreWhiteSpace(T &source);
+        void ignoreWhiteSpace(IndexedSource &source);
+        template <typename T>
+        std::string_view extractString(T &source);
+        std::string_view extractString(IndexedSource &source);
+        template <typename T>
+        void extractDigits(T &source);
+        template <typename T>
+        JNumeric extractNumber(T &source);
+        template <typename T>
+        bool extractBoolean(T &source);
+        template <typename T>
+        void extractNull(T &source);
+        template <typename T>
+        std::unique_ptr<JNode> parseJNodes(T &source);
+        template <typename T>
+        std::unique_ptr<JNode> parseString(T &source);
+        template <typename T>
+        std::unique_ptr<JNode> parseNumber(T &source, JNodeArray *jNodeArray);
+        template <typename T>
+        std::unique_ptr<JNode> parseBoolean(T &source);
+        template <typename T>
+        std::unique_ptr<JNode> parseNull(T &source);
+        template <typename T>
+        void pushContainer(T &source, JNodeType nodeType, JNode *jNode, std::size_t base);
+        template <typename T>
+        std::string_view parseKey(T &source);
+        template <typename T>
+        bool moveToNextEntry(T &source, JNodeType nodeType);
+        template <typename T>
+        void parseEvents(T &source, IHandler &handler);
+        template <typename T>
+        JValue parseJValues(T &source);
+        JNode *parseJNodesInArena(IndexedSource &source, std::pmr::memory_resource *arena);
+        JValue parseJValuesInArena(IndexedSource &source, std::pmr::memory_resource *arena);
+        void stringifyNumber(const JNumeric &numeric, IDestination &destination);
+        void stringifyPackedNumbers(const JNodeArray &jNodeArray, IDestination &destination);
+        void stringifyString(std::string_view string, IDestination &destination);
+        void stringifyJValues(const JValue &jValueRoot, IDestination &destination);
+        void stringifyTape(const JSONTape &tape, IDestination &destination);
+        void stringifyJNodes(const JNode &jNode, IDestination &destination);
+        template <typename T>
+        void stripWhiteSpace(T &source, IDestination &destination);
+        static JSONPointer parsePointer(std::string_view pointer, std::size_t result);
+        static void resolvePointers(const std::vector<const JSONPointer *> &pointers, std::size_t &remaining);
+        template <typename T>
+        void skipValue(T &source);
+        template <typename T>
+        void extractPointers(T &source, const std::vector<const JSONPointer *> &pointers, std::size_t depth,
+                             std::vector<std::unique_ptr<JNode>> &results, std::size_t &remaining, bool stopWhenResolved);
+        template <typename T>
+        std::vector<std::unique_ptr<JNode>> extractAll(T &source, const std::vector<std::string> &pointers);
+        std::unique_ptr<JNode> copyMatched(JNode *jNode, const JSONPointer &pointer, std::size_t depth);
+        void parseElements(IndexedSource &source, JNodeArray &elements);
+        void parseElementEvents(IndexedSource &source, IHandler &handler);
+        static WorkState &threadWorkState();
+        static std::vector<std::string_view> splitArrayIntoRuns(std::string_view jsonBuffer, const std::vector<std::uint32_t> &index, unsigned threadCount);
         // =================
         // PRIVATE VARIABLES
         // =================
-        std::string m_workBuffer;
+        // Settings; these are all that is copied with a JSON object
         ITranslator *m_jsonTranslator;
+        bool m_keepNumberText = false;
+        bool m_packNumbers = false;
+        std::size_t m_maxNestingDepth = kDefaultMaxNestingDepth;
+        // Work state of a parse/stringify; public methods only ever use
+        // that of a copy made for the call so a JSON object may be used by
+        // several threads at once (see WorkScope).
+        std::string m_workBuffer;
+        std::pmr::memory_resource *m_arena = nullptr;
+        std::vector<JValue> m_jValueStack;
+        std::vector<JNodeFrame> m_jNodeStack;
+        std::vector<StringifyFrame> m_stringifyStack;
+    };
+    //
+    // Copy of a JSON object that a public method runs on. For as long as
+    // it exists the copy has the work buffer and stacks kept for the
+    // calling thread, handing them back when it goes out of scope; a scope
+    // nested on the same thread just starts with empty ones.
+    //
+    struct JSON::WorkScope
+    {
+    public:
+        explicit WorkScope(const JSON &settings);
+        ~WorkScope();
+        WorkScope(const WorkScope &other) = delete;
+        WorkScope &operator=(const WorkScope &other) = delete;
+        JSON json;
     };
 } // namespace H4
 #endif /* JSON_HPP */
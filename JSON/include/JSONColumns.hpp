@@ -0,0 +1,189 @@
+#ifndef JSONCOLUMNS_HPP
+#define JSONCOLUMNS_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+//
+// JSON JNodes
+//
+#include "JNode.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    //
+    // One field of an array of objects (records) extracted as a typed
+    // column with a row per record (see JSON::extractColumns()). Numbers
+    // are held in a contiguous vector of doubles or 64 bit integers and
+    // strings in one arena with the offset of each row (plus a final end
+    // offset). A row is null where its record does not have the field or
+    // its value is null or not of the column type (an integer column only
+    // takes numbers with an exact integer value); the bitmap has a set bit
+    // (row % 64 of word row / 64) for each null row whose value is left as
+    // zero/empty.
+    //
+    struct JSONColumn
+    {
+    public:
+        enum class Type : std::uint8_t
+        {
+            floatingPoint = 0,
+            integer = 1,
+            string = 2
+        };
+        //
+        // Field to extract and its column type.
+        //
+        struct Field
+        {
+            std::string name;
+            Type type;
+        };
+        JSONColumn(const Field &field) : name(field.name), type(field.type)
+        {
+            if (type == Type::string)
+            {
+                offsets.push_back(0);
+            }
+        }
+        std::size_t rows() const
+        {
+            return (m_rows);
+        }
+        bool isNull(std::size_t row) const
+        {
+            return ((nullBitmap[row / 64] >> (row % 64)) & 1);
+        }
+        std::string_view getString(std::size_t row) const
+        {
+            return (std::string_view(strings).substr(offsets[row], offsets[row + 1] - offsets[row]));
+        }
+        //
+        // Add a row (used while extracting)
+        //
+        void appendNull()
+        {
+            appendRow(true);
+        }
+        void appendNumber(const JNumeric &numeric)
+        {
+            switch (type)
+            {
+            case Type::floatingPoint:
+                numeric.getFloatingPoint(floatingPoints.emplace_back());
+                appendRow(false);
+                break;
+            case Type::integer:
+                if (numeric.kind == JNumeric::Kind::integer)
+                {
+                    integers.push_back(numeric.integer);
+                    appendRow(false);
+                }
+                else if ((numeric.kind == JNumeric::Kind::unsignedInteger) && (numeric.unsignedInteger <= (unsigned long long)INT64_MAX))
+                {
+                    integers.push_back((std::int64_t)numeric.unsignedInteger);
+                    appendRow(false);
+                }
+                else if ((numeric.kind == JNumeric::Kind::floatingPoint) && (std::trunc(numeric.floatingPoint) == numeric.floatingPoint) &&
+                         (numeric.floatingPoint >= -9223372036854775808.0) && (numeric.floatingPoint < 9223372036854775808.0))
+                {
+                    integers.push_back((std::int64_t)numeric.floatingPoint);
+                    appendRow(false);
+                }
+                else
+                {
+                    appendNull();
+                }
+                break;
+            default:
+                appendNull();
+                break;
+            }
+        }
+        void appendString(std::string_view string)
+        {
+            if (type != Type::string)
+            {
+                appendNull();
+                return;
+            }
+            strings.append(string);
+            appendRow(false);
+        }
+        void appendColumn(const JSONColumn &column)
+        {
+            if ((column.name != name) || (column.type != type))
+            {
+                throw std::invalid_argument("Columns for different fields cannot be joined.");
+            }
+            floatingPoints.insert(floatingPoints.end(), column.floatingPoints.begin(), column.floatingPoints.end());
+            integers.insert(integers.end(), column.integers.begin(), column.integers.end());
+            std::size_t base = strings.size();
+            strings.append(column.strings);
+            for (std::size_t row = 0; row < column.rows(); row++)
+            {
+                if (type == Type::string)
+                {
+                    offsets.push_back(base + column.offsets[row + 1]);
+                }
+                markRow(column.isNull(row));
+            }
+        }
+        // Field and type
+        std::string name;
+        Type type;
+        // Values for floating point/integer columns
+        std::vector<double> floatingPoints;
+        std::vector<std::int64_t> integers;
+        // Values for string columns
+        std::string strings;
+        std::vector<std::size_t> offsets;
+        // Set bit per null row
+        std::vector<std::uint64_t> nullBitmap;
+
+    private:
+        void appendRow(bool null)
+        {
+            if (null)
+            {
+                switch (type)
+                {
+                case Type::floatingPoint:
+                    floatingPoints.push_back(0.0);
+                    break;
+                case Type::integer:
+                    integers.push_back(0);
+                    break;
+                default:
+                    break;
+                }
+            }
+            if (type == Type::string)
+            {
+                offsets.push_back(strings.size());
+            }
+            markRow(null);
+        }
+        void markRow(bool null)
+        {
+            if ((m_rows % 64) == 0)
+            {
+                nullBitmap.push_back(0);
+            }
+            if (null)
+            {
+                nullBitmap.back() |= (std::uint64_t)1 << (m_rows % 64);
+            }
+            m_rows++;
+        }
+        std::size_t m_rows = 0;
+    };
+} // namespace H4
+#endif /* JSONCOLUMNS_HPP */
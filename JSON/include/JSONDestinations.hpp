@@ -2,6 +2,9 @@
 #define JSONSTINATIONS_HPP
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <stdexcept>
 namespace H4
 {
     //
@@ -13,38 +16,117 @@ namespace H4
         BufferDestination()
         {
         }
-        void addBytes(std::string bytes)
+        void addByte(char byte)
         {
-            for (auto b : bytes)
-            {
-                m_stringifyBuffer.push_back(b);
-            }
+            m_stringifyBuffer.push_back(byte);
         }
-        std::string getBuffer()
+        void addBytes(std::string_view bytes)
+        {
+            m_stringifyBuffer.append(bytes.data(), bytes.size());
+        }
+        std::string &getBuffer()
         {
             return (m_stringifyBuffer);
         }
     private:
         std::string m_stringifyBuffer;
     };
+    //
+    // File destination. Bytes are gathered in a block buffer which is only
+    // written to the file when it fills, on flush() or when the destination
+    // is destroyed. The file stream is unbuffered so each block is passed
+    // straight to the file rather than copied into the stream's buffer
+    // too. A failed write throws; as a destructor cannot, call flush()
+    // before then to be told of any error writing the last block.
+    //
     class FileDestination : public JSON::IDestination
     {
     public:
+        // Size of block buffer
+        static constexpr std::size_t kBlockSize = 64 * 1024;
         FileDestination(std::string desinationFileName)
         {
+            m_destination.rdbuf()->pubsetbuf(nullptr, 0);
             m_destination.open(desinationFileName.c_str(), std::ios_base::binary);
             if (!m_destination.is_open())
             {
                 throw std::runtime_error("JSON file output stream failed to open or could not be created.");
             }
+            m_block.reserve(kBlockSize);
+        }
+        FileDestination(FileDestination &&other) = default;
+        FileDestination &operator=(FileDestination &&other)
+        {
+            flush();
+            m_destination = std::move(other.m_destination);
+            m_block = std::move(other.m_block);
+            other.m_block.clear();
+            return (*this);
+        }
+        ~FileDestination()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+        }
+        void addByte(char byte)
+        {
+            if (m_block.size() == kBlockSize)
+            {
+                writeBlock();
+            }
+            m_block.push_back(byte);
         }
-        void addBytes(std::string bytes)
+        void addBytes(std::string_view bytes)
         {
-            m_destination.write(bytes.c_str(), bytes.length());
-            m_destination.flush();
+            if (m_block.size() + bytes.size() > kBlockSize)
+            {
+                writeBlock();
+                if (bytes.size() >= kBlockSize)
+                {
+                    writeBytes(bytes);
+                    return;
+                }
+            }
+            m_block.append(bytes.data(), bytes.size());
+        }
+        // Write any buffered bytes out to the file
+        void flush()
+        {
+            if (m_destination.is_open())
+            {
+                writeBlock();
+                m_destination.flush();
+                checkWritten();
+            }
         }
     private:
+        void writeBlock()
+        {
+            writeBytes(m_block);
+            m_block.clear();
+        }
+        void writeBytes(std::string_view bytes)
+        {
+            if (m_destination.rdbuf()->sputn(bytes.data(), bytes.size()) != (std::streamsize)bytes.size())
+            {
+                m_destination.setstate(std::ios_base::badbit);
+            }
+            checkWritten();
+        }
+        void checkWritten()
+        {
+            if (!m_destination.good())
+            {
+                throw std::runtime_error("JSON file output stream failed to write.");
+            }
+        }
         std::ofstream m_destination;
+        std::string m_block;
     };
 } // namespace H4
-#endif /* JSONSTINATIONS_HPP */
\ No newline at end of file
+#endif /* JSONSTINATIONS_HPP */
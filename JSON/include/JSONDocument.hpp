@@ -0,0 +1,84 @@
+#ifndef JSONDOCUMENT_HPP
+#define JSONDOCUMENT_HPP
+//
+// C++ STL
+//
+#include <memory>
+#include <memory_resource>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+//
+// JSON JNodes
+//
+#include "JNode.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    //
+    // A parsed JNode tree whose nodes and strings are all allocated from
+    // a single monotonic arena owned by the document. Nodes are never
+    // destroyed individually; the whole arena is released in one go when
+    // the document goes. Note: JNodes inside a document must not be moved
+    // out of it (for example from JNodeArray::getArray()) and any added to
+    // it must be created with makeJNode().
+    //
+    class JSONDocument
+    {
+    public:
+        // Smallest arena allocated up front for a document
+        static constexpr std::size_t kMinimumArenaSize = 4096;
+        JSONDocument(std::size_t initialArenaSize = kMinimumArenaSize)
+            : m_arena(std::make_unique<std::pmr::monotonic_buffer_resource>(std::max(initialArenaSize, kMinimumArenaSize)))
+        {
+        }
+        JSONDocument(JSONDocument &&other) noexcept
+            : m_arena(std::move(other.m_arena)), m_root(std::exchange(other.m_root, nullptr))
+        {
+        }
+        JSONDocument &operator=(JSONDocument &&other) noexcept
+        {
+            m_arena = std::move(other.m_arena);
+            m_root = std::exchange(other.m_root, nullptr);
+            return (*this);
+        }
+        JNode &root() const
+        {
+            if (m_root == nullptr)
+            {
+                throw std::runtime_error("JSONDocument does not contain a JNode tree.");
+            }
+            return (*m_root);
+        }
+        std::pmr::memory_resource *arena()
+        {
+            return (m_arena.get());
+        }
+        // Create a JNode in the document arena; only these may be added to
+        // the objects/arrays of the document.
+        template <typename T, typename... Args>
+        std::unique_ptr<JNode> makeJNode(Args &&...args)
+        {
+            T *jNode;
+            if constexpr (std::is_constructible_v<T, Args..., std::pmr::memory_resource *>)
+            {
+                jNode = new (m_arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)..., m_arena.get());
+            }
+            else
+            {
+                jNode = new (m_arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            }
+            jNode->arenaOwned = true;
+            return (std::unique_ptr<JNode>(jNode));
+        }
+
+    private:
+        friend class JSON;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> m_arena;
+        JNode *m_root = nullptr;
+    };
+} // namespace H4
+#endif /* JSONDOCUMENT_HPP */
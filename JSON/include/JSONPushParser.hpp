@@ -0,0 +1,100 @@
+#ifndef JSONPUSHPARSER_HPP
+#define JSONPUSHPARSER_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+//
+// JSON
+//
+#include "JSON.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ================
+    // CLASS DEFINITION
+    // ================
+    class JSONPushParser
+    {
+    public:
+        // ==========================
+        // PUBLIC TYPES AND CONSTANTS
+        // ==========================
+        // ============
+        // CONSTRUCTORS
+        // ============
+        JSONPushParser(JSON::ITranslator *translator = nullptr);
+        JSONPushParser(JSON::IHandler &handler, JSON::ITranslator *translator = nullptr);
+        // ==========
+        // DESTRUCTOR
+        // ==========
+        ~JSONPushParser();
+        // ==============
+        // PUBLIC METHODS
+        // ==============
+        void feed(std::string_view chunk);
+        void finish();
+        bool isComplete() const;
+        std::unique_ptr<JNode> getRoot();
+        void keepNumberText(bool keepNumberText);
+        void packNumbers(bool packNumbers);
+        void maxNestingDepth(std::size_t maxNestingDepth);
+        // ================
+        // PUBLIC VARIABLES
+        // ================
+    private:
+        // ===========================
+        // PRIVATE TYPES AND CONSTANTS
+        // ===========================
+        //
+        // What is expected next in the JSON.
+        //
+        enum class State
+        {
+            value,
+            nextEntry,
+            colon,
+            afterValue,
+            string,
+            number,
+            literal,
+            finished
+        };
+        // Handler that builds a JNode structure from the parse events
+        struct JNodeBuilder;
+        // ===========================================
+        // DISABLED CONSTRUCTORS/DESTRUCTORS/OPERATORS
+        // ===========================================
+        JSONPushParser(const JSONPushParser &other) = delete;
+        JSONPushParser &operator=(const JSONPushParser &other) = delete;
+        // ===============
+        // PRIVATE METHODS
+        // ===============
+        void startValue(char byte);
+        void pushContainer(char byte);
+        void closeContainer(char byte);
+        void valueFinished();
+        void finishString();
+        void finishNumber();
+        void finishLiteral();
+        // =================
+        // PRIVATE VARIABLES
+        // =================
+        JSON m_json;
+        std::unique_ptr<JNodeBuilder> m_builder;
+        JSON::IHandler *m_handler;
+        std::vector<char> m_containers;
+        State m_state = State::value;
+        // Partial token (escaped string, number or literal) carried across
+        // chunks
+        std::string m_token;
+        bool m_stringIsKey = false;
+        bool m_escaped = false;
+    };
+} // namespace H4
+#endif /* JSONPUSHPARSER_HPP */
@@ -0,0 +1,133 @@
+#ifndef JSONREADER_HPP
+#define JSONREADER_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+//
+// JSON
+//
+#include "JSON.hpp"
+#include "JSONSources.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ================
+    // CLASS DEFINITION
+    // ================
+    class JSONReader
+    {
+    public:
+        // ==========================
+        // PUBLIC TYPES AND CONSTANTS
+        // ==========================
+        //
+        // Tokens returned by next().
+        //
+        enum class Token
+        {
+            none = 0,
+            objectStart,
+            objectEnd,
+            arrayStart,
+            arrayEnd,
+            key,
+            string,
+            number,
+            boolean,
+            null,
+            end
+        };
+        // ============
+        // CONSTRUCTORS
+        // ============
+        JSONReader(std::string_view jsonBuffer, JSON::ITranslator *translator = nullptr);
+        JSONReader(JSON::ISource &source, JSON::ITranslator *translator = nullptr);
+        // ==========
+        // DESTRUCTOR
+        // ==========
+        // ==============
+        // PUBLIC METHODS
+        // ==============
+        Token next();
+        void skipValue();
+        void maxNestingDepth(std::size_t maxNestingDepth);
+        Token getToken() const
+        {
+            return (m_token);
+        }
+        // Container nesting depth of the current token
+        int getDepth() const
+        {
+            return ((int)m_containers.size());
+        }
+        // Key or string value (valid until the next call to next())
+        std::string_view getString() const
+        {
+            return (m_string);
+        }
+        const JNumeric &getNumeric() const
+        {
+            return (m_numeric);
+        }
+        // Text of number (valid until the next call to next())
+        std::string_view getNumber() const
+        {
+            return (m_string);
+        }
+        bool getBoolean() const
+        {
+            return (m_boolean);
+        }
+        // ================
+        // PUBLIC VARIABLES
+        // ================
+    private:
+        // ===========================
+        // PRIVATE TYPES AND CONSTANTS
+        // ===========================
+        //
+        // What is expected next in the JSON.
+        //
+        enum class State
+        {
+            value,
+            key,
+            afterValue,
+            finished
+        };
+        // ===========================================
+        // DISABLED CONSTRUCTORS/DESTRUCTORS/OPERATORS
+        // ===========================================
+        // ===============
+        // PRIVATE METHODS
+        // ===============
+        void pushContainer(Token container);
+        std::string_view translateString(std::string_view jsonString);
+        template <typename T>
+        Token nextToken(T &source);
+        template <typename T>
+        Token readKey(T &source);
+        template <typename T>
+        Token readValue(T &source);
+        template <typename T>
+        void skipContainer(T &source);
+        // =================
+        // PRIVATE VARIABLES
+        // =================
+        JSON m_json;
+        SpanSource m_span;
+        JSON::ISource *m_source = nullptr;
+        std::vector<Token> m_containers;
+        State m_state = State::value;
+        Token m_token = Token::none;
+        std::string_view m_string;
+        JNumeric m_numeric;
+        bool m_boolean = false;
+    };
+} // namespace H4
+#endif /* JSONREADER_HPP */
@@ -1,7 +1,19 @@
 #ifndef JSONSOURCES_HPP
 #define JSONSOURCES_HPP
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define JSON_MAPPED_FILES 1
+#endif
 namespace H4
 {
     //
@@ -74,5 +86,231 @@ namespace H4
     private:
         std::ifstream m_source;
     };
+    //
+    // Source over a contiguous span of bytes. This does not derive from
+    // ISource so that the templated parser can inline its methods; the
+    // bytes are not copied and must outlive the source. Note: moveToNextByte()
+    // does not bounds check so callers must test bytesToParse() first.
+    //
+    class SpanSource
+    {
+    public:
+        SpanSource(std::string_view sourceBuffer)
+            : m_current(sourceBuffer.data()), m_end(sourceBuffer.data() + sourceBuffer.size())
+        {
+        }
+        char currentByte() const
+        {
+            return ((m_current < m_end) ? *m_current : (char)EOF);
+        }
+        void moveToNextByte()
+        {
+            m_current++;
+        }
+        bool bytesToParse() const
+        {
+            return (m_current < m_end);
+        }
+        std::size_t bytesRemaining() const
+        {
+            return (m_end - m_current);
+        }
+        std::string_view remainingBytes() const
+        {
+            return (std::string_view(m_current, bytesRemaining()));
+        }
+
+    protected:
+        const char *m_current;
+        const char *m_end;
+    };
+    //
+    // Build structural index for a JSON buffer (JSON_index.cpp).
+    //
+    void buildStructuralIndex(std::string_view jsonBuffer, std::vector<std::uint32_t> &index);
+    //
+    // Span source with a structural index built for it up front (stage one
+    // of a two stage parse). The parser uses the index to skip runs of
+    // whitespace and whole strings in one step. Index offsets are 32 bit so
+    // a buffer of kMaxIndexedSize bytes or more is not indexed and is
+    // instead scanned a byte at a time as for a SpanSource.
+    //
+    class IndexedSource : public SpanSource
+    {
+    public:
+        // Largest buffer (exclusive) that is given a structural index
+        static constexpr std::size_t kMaxIndexedSize = UINT32_MAX;
+        IndexedSource(std::string_view sourceBuffer, std::size_t maxIndexedSize = kMaxIndexedSize)
+            : SpanSource(sourceBuffer), m_start(sourceBuffer.data()), m_indexed(sourceBuffer.size() < std::min(maxIndexedSize, kMaxIndexedSize))
+        {
+            if (m_indexed)
+            {
+                buildStructuralIndex(sourceBuffer, m_index);
+            }
+        }
+        // Source for part of an already indexed buffer using the entries of
+        // its index (offsets from bufferStart) that fall within that part
+        IndexedSource(std::string_view sourceBuffer, const char *bufferStart, const std::vector<std::uint32_t> &index)
+            : SpanSource(sourceBuffer), m_start(sourceBuffer.data())
+        {
+            std::uint32_t first = (std::uint32_t)(sourceBuffer.data() - bufferStart);
+            auto entry = std::lower_bound(index.begin(), index.end(), first);
+            auto last = std::lower_bound(entry, index.end(), (std::uint32_t)(first + sourceBuffer.size()));
+            m_index.reserve(last - entry);
+            for (; entry != last; entry++)
+            {
+                m_index.push_back(*entry - first);
+            }
+        }
+        bool isIndexed() const
+        {
+            return (m_indexed);
+        }
+        // Move to the next non-whitespace byte
+        void skipWhiteSpace()
+        {
+            if ((m_current < m_end) && !isWhiteSpace(*m_current))
+            {
+                return;
+            }
+            if (!m_indexed)
+            {
+                while ((m_current < m_end) && isWhiteSpace(*m_current))
+                {
+                    m_current++;
+                }
+                return;
+            }
+            std::size_t offset = m_current - m_start;
+            while ((m_nextEntry < m_index.size()) && (m_index[m_nextEntry] <= offset))
+            {
+                m_nextEntry++;
+            }
+            m_current = (m_nextEntry < m_index.size()) ? m_start + m_index[m_nextEntry] : m_end;
+        }
+        // Return the contents of the string whose opening quote is the
+        // current byte and move past its closing quote. Returns false if
+        // not on an opening quote or the string is not terminated.
+        bool skipString(std::string_view &contents)
+        {
+            if (!m_indexed)
+            {
+                return (scanString(contents));
+            }
+            std::size_t offset = m_current - m_start;
+            while ((m_nextEntry < m_index.size()) && (m_index[m_nextEntry] < offset))
+            {
+                m_nextEntry++;
+            }
+            if ((m_nextEntry + 1 >= m_index.size()) || (m_index[m_nextEntry] != offset) || (*m_current != '"'))
+            {
+                return (false);
+            }
+            std::size_t closingQuote = m_index[m_nextEntry + 1];
+            contents = std::string_view(m_current + 1, closingQuote - offset - 1);
+            m_current = m_start + closingQuote + 1;
+            m_nextEntry += 2;
+            return (true);
+        }
+
+    private:
+        static bool isWhiteSpace(char c)
+        {
+            return ((c == ' ') || ((c >= '\t') && (c <= '\r')));
+        }
+        // skipString() for an unindexed buffer
+        bool scanString(std::string_view &contents)
+        {
+            if ((m_current >= m_end) || (*m_current != '"'))
+            {
+                return (false);
+            }
+            for (const char *next = m_current + 1; next < m_end; next++)
+            {
+                if (*next == '\\')
+                {
+                    next++;
+                }
+                else if (*next == '"')
+                {
+                    contents = std::string_view(m_current + 1, next - m_current - 1);
+                    m_current = next + 1;
+                    return (true);
+                }
+            }
+            return (false);
+        }
+        const char *m_start;
+        bool m_indexed = true;
+        std::vector<std::uint32_t> m_index;
+        std::size_t m_nextEntry = 0;
+    };
+    //
+    // Source for a whole file presented to the parser as one contiguous
+    // span. Where supported the file is memory mapped, otherwise (or if
+    // the map fails) it is read into a buffer in one go.
+    //
+    class MappedFileSource : public SpanSource
+    {
+    public:
+        MappedFileSource(const std::string &sourceFileName) : SpanSource(std::string_view())
+        {
+#ifdef JSON_MAPPED_FILES
+            int fileDescriptor = ::open(sourceFileName.c_str(), O_RDONLY);
+            if (fileDescriptor == -1)
+            {
+                throw std::runtime_error("JSON file input stream failed to open or does not exist.");
+            }
+            struct stat fileStatus;
+            if ((::fstat(fileDescriptor, &fileStatus) == 0) && (fileStatus.st_size > 0))
+            {
+                void *mapped = ::mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                if (mapped != MAP_FAILED)
+                {
+                    ::madvise(mapped, fileStatus.st_size, MADV_SEQUENTIAL);
+                    m_mappedFile = mapped;
+                    m_mappedSize = fileStatus.st_size;
+                    m_current = static_cast<const char *>(mapped);
+                    m_end = m_current + m_mappedSize;
+                }
+            }
+            ::close(fileDescriptor);
+            if (m_mappedFile != nullptr)
+            {
+                return;
+            }
+#endif
+            readFile(sourceFileName);
+        }
+        MappedFileSource(const MappedFileSource &other) = delete;
+        MappedFileSource &operator=(const MappedFileSource &other) = delete;
+        ~MappedFileSource()
+        {
+#ifdef JSON_MAPPED_FILES
+            if (m_mappedFile != nullptr)
+            {
+                ::munmap(m_mappedFile, m_mappedSize);
+            }
+#endif
+        }
+
+    private:
+        void readFile(const std::string &sourceFileName)
+        {
+            std::ifstream source(sourceFileName.c_str(), std::ios_base::binary);
+            if (!source.is_open())
+            {
+                throw std::runtime_error("JSON file input stream failed to open or does not exist.");
+            }
+            std::ostringstream fileBuffer;
+            fileBuffer << source.rdbuf();
+            m_fileBuffer = fileBuffer.str();
+            m_current = m_fileBuffer.data();
+            m_end = m_current + m_fileBuffer.size();
+        }
+        void *m_mappedFile = nullptr;
+        std::size_t m_mappedSize = 0;
+        std::string m_fileBuffer;
+    };
 } // namespace H4
 #endif /* JSONSOURCES_HPP */
\ No newline at end of file
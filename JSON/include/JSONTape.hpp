@@ -0,0 +1,339 @@
+#ifndef JSONTAPE_HPP
+#define JSONTAPE_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+//
+// JSON JNodes
+//
+#include "JNode.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    //
+    // Fixed size (16 byte) entry on a JSONTape. Values are laid out in
+    // document order; an object/array entry is followed by its children
+    // (each object member being a string key entry then its value) and
+    // holds the index of the entry just past its last child so that it can
+    // be skipped over in one step. Strings hold their length and offset
+    // into the tape string arena; numbers/booleans their value inline.
+    //
+    struct JTapeEntry
+    {
+        std::uint8_t type;      // JNodeType
+        std::uint8_t info;      // JNumeric::Kind of a number
+        std::uint16_t reserved; // Always zero
+        std::uint32_t size;     // Object members/array elements/string length
+        std::uint64_t payload;  // Index past children/string offset/value
+    };
+    static_assert(sizeof(JTapeEntry) == 16, "JTapeEntry should be 16 bytes.");
+    //
+    // Read only cursor onto a value on a JSONTape; accessors mirror those of
+    // the JNode types. A JTapeValue is only valid while its tape is.
+    // Looking up an object key or an array index steps through the entries
+    // before it, so iterate rather than index when visiting them all.
+    //
+    class JTapeValue
+    {
+    public:
+        //
+        // Iterates the elements of an array or the members of an object
+        // (key() then giving the member key).
+        //
+        class Iterator
+        {
+        public:
+            JTapeValue operator*() const
+            {
+                return (JTapeValue(m_entries, m_strings, valueIndex()));
+            }
+            Iterator &operator++()
+            {
+                m_index = JTapeValue(m_entries, m_strings, valueIndex()).nextIndex();
+                return (*this);
+            }
+            bool operator==(const Iterator &other) const
+            {
+                return (m_index == other.m_index);
+            }
+            bool operator!=(const Iterator &other) const
+            {
+                return (m_index != other.m_index);
+            }
+            std::string_view key() const
+            {
+                if (!m_object)
+                {
+                    throw std::runtime_error("JTapeValue is not an object.");
+                }
+                return (JTapeValue(m_entries, m_strings, m_index).getString());
+            }
+
+        private:
+            friend class JTapeValue;
+            Iterator(const JTapeEntry *entries, const char *strings, std::size_t index, bool object)
+                : m_entries(entries), m_strings(strings), m_index(index), m_object(object)
+            {
+            }
+            std::size_t valueIndex() const
+            {
+                return (m_object ? m_index + 1 : m_index);
+            }
+            const JTapeEntry *m_entries;
+            const char *m_strings;
+            std::size_t m_index;
+            bool m_object;
+        };
+        //
+        // Type
+        //
+        JNodeType getNodeType() const
+        {
+            return ((JNodeType)entry().type);
+        }
+        bool isInteger() const
+        {
+            return ((getNodeType() == JNodeType::number) && (entry().info != (std::uint8_t)JNumeric::Kind::floatingPoint));
+        }
+        //
+        // Object/Array
+        //
+        int size() const
+        {
+            if (isContainer())
+            {
+                return ((int)entry().size);
+            }
+            return (0);
+        }
+        Iterator begin() const
+        {
+            if (!isContainer())
+            {
+                throw std::runtime_error("JTapeValue is not an object or array.");
+            }
+            return (Iterator(m_entries, m_strings, m_index + 1, getNodeType() == JNodeType::object));
+        }
+        Iterator end() const
+        {
+            if (!isContainer())
+            {
+                throw std::runtime_error("JTapeValue is not an object or array.");
+            }
+            return (Iterator(m_entries, m_strings, (std::size_t)entry().payload, getNodeType() == JNodeType::object));
+        }
+        bool containsKey(std::string_view key) const
+        {
+            return (findEntry(key) != kNotFound);
+        }
+        std::string_view getKey(int index) const
+        {
+            if ((getNodeType() != JNodeType::object) || (index < 0) || (index >= size()))
+            {
+                throw std::runtime_error("Invalid index used to access object keys.");
+            }
+            Iterator member = begin();
+            while (index-- > 0)
+            {
+                ++member;
+            }
+            return (member.key());
+        }
+        std::vector<std::string_view> getKeys() const
+        {
+            std::vector<std::string_view> keys;
+            if (getNodeType() == JNodeType::object)
+            {
+                keys.reserve(size());
+                for (Iterator member = begin(); member != end(); ++member)
+                {
+                    keys.push_back(member.key());
+                }
+            }
+            return (keys);
+        }
+        JTapeValue operator[](std::string_view key) const
+        {
+            std::size_t index = findEntry(key);
+            if (index == kNotFound)
+            {
+                throw std::runtime_error("Invalid key used to access object.");
+            }
+            return (JTapeValue(m_entries, m_strings, index));
+        }
+        JTapeValue operator[](int index) const
+        {
+            if (isContainer() && (index >= 0) && (index < size()))
+            {
+                Iterator element = begin();
+                while (index-- > 0)
+                {
+                    ++element;
+                }
+                return (*element);
+            }
+            throw std::runtime_error("Invalid index used to access array.");
+        }
+        //
+        // Scalars
+        //
+        std::string_view getString() const
+        {
+            checkType(JNodeType::string, "JTapeValue is not a string.");
+            return (std::string_view(m_strings + entry().payload, entry().size));
+        }
+        JNumeric getNumeric() const
+        {
+            checkType(JNodeType::number, "JTapeValue is not a number.");
+            JNumeric numeric;
+            numeric.kind = (JNumeric::Kind)entry().info;
+            std::memcpy(&numeric.integer, &entry().payload, sizeof(numeric.integer));
+            return (numeric);
+        }
+        std::string getNumber() const
+        {
+            return (getNumeric().toString());
+        }
+        // Same semantics as JNodeNumber: returns true only when the number is an integer
+        bool getInteger(long &longValue) const
+        {
+            return (getNumeric().getInteger(longValue));
+        }
+        bool getFloatingPoint(double &doubleValue) const
+        {
+            return (getNumeric().getFloatingPoint(doubleValue));
+        }
+        bool getBoolean() const
+        {
+            checkType(JNodeType::boolean, "JTapeValue is not a boolean.");
+            return (entry().payload != 0);
+        }
+        void *getNull() const
+        {
+            checkType(JNodeType::null, "JTapeValue is not a null.");
+            return (nullptr);
+        }
+
+    private:
+        friend class JSONTape;
+        static constexpr std::size_t kNotFound = (std::size_t)-1;
+        JTapeValue(const JTapeEntry *entries, const char *strings, std::size_t index)
+            : m_entries(entries), m_strings(strings), m_index(index)
+        {
+        }
+        const JTapeEntry &entry() const
+        {
+            return (m_entries[m_index]);
+        }
+        bool isContainer() const
+        {
+            return ((getNodeType() == JNodeType::object) || (getNodeType() == JNodeType::array));
+        }
+        void checkType(JNodeType nodeType, const char *errorMessage) const
+        {
+            if (getNodeType() != nodeType)
+            {
+                throw std::runtime_error(errorMessage);
+            }
+        }
+        // Index of the entry following this value (and any children)
+        std::size_t nextIndex() const
+        {
+            return (isContainer() ? (std::size_t)entry().payload : m_index + 1);
+        }
+        std::size_t findEntry(std::string_view key) const
+        {
+            if (getNodeType() == JNodeType::object)
+            {
+                for (Iterator member = begin(); member != end(); ++member)
+                {
+                    if (member.key() == key)
+                    {
+                        return (member.valueIndex());
+                    }
+                }
+            }
+            return (kNotFound);
+        }
+        const JTapeEntry *m_entries;
+        const char *m_strings;
+        std::size_t m_index;
+    };
+    // ================
+    // CLASS DEFINITION
+    // ================
+    //
+    // A JNode tree frozen into one contiguous, pointer free tape of
+    // JTapeEntrys plus an arena of the (decoded) strings they reference.
+    // Both are plain bytes so a tape can be copied with memcpy and saved/
+    // loaded with toBuffer()/fromBuffer() (in native byte order). Numbers
+    // are kept as their native values only, not their original text.
+    //
+    class JSONTape
+    {
+    public:
+        // ==========================
+        // PUBLIC TYPES AND CONSTANTS
+        // ==========================
+        // ============
+        // CONSTRUCTORS
+        // ============
+        JSONTape() = default;
+        // ==========
+        // DESTRUCTOR
+        // ==========
+        // ==============
+        // PUBLIC METHODS
+        // ==============
+        static JSONTape freeze(const JNode &jNodeRoot);
+        static JSONTape fromBuffer(std::string_view tapeBuffer);
+        std::string toBuffer() const;
+        JTapeValue root() const
+        {
+            if (m_entries.empty())
+            {
+                throw std::runtime_error("JSONTape does not contain a frozen JNode tree.");
+            }
+            return (JTapeValue(m_entries.data(), m_strings.data(), 0));
+        }
+        const std::vector<JTapeEntry> &entries() const
+        {
+            return (m_entries);
+        }
+        std::string_view strings() const
+        {
+            return (m_strings);
+        }
+        // ================
+        // PUBLIC VARIABLES
+        // ================
+    private:
+        // ===========================
+        // PRIVATE TYPES AND CONSTANTS
+        // ===========================
+        // ===========================================
+        // DISABLED CONSTRUCTORS/DESTRUCTORS/OPERATORS
+        // ===========================================
+        // ===============
+        // PRIVATE METHODS
+        // ===============
+        void appendEntry(const JNode &jNode);
+        void appendString(std::string_view string);
+        void appendNumber(const JNumeric &numeric);
+        void validate() const;
+        // =================
+        // PRIVATE VARIABLES
+        // =================
+        std::vector<JTapeEntry> m_entries;
+        std::string m_strings;
+    };
+} // namespace H4
+#endif /* JSONTAPE_HPP */
@@ -4,8 +4,7 @@
 // C++ STL
 //
 #include <string>
-#include <codecvt>
-#include <locale>
+#include <string_view>
 // =========
 // NAMESPACE
 // =========
@@ -23,9 +22,10 @@ namespace H4
         // ============
         // CONSTRUCTORS
         // ============
-        JSONTranslator()
+        // If rawUTF8 is set non-ASCII characters are written to JSON strings
+        // as UTF-8 rather than being escaped as "\uxxxx".
+        JSONTranslator(bool rawUTF8 = false) : m_rawUTF8(rawUTF8)
         {
-            initialiseTranslationMaps();
         }
         // ==========
         // DESTRUCTOR
@@ -33,8 +33,8 @@ namespace H4
         // ==============
         // PUBLIC METHODS
         // ==============
-        std::string fromEscapeSequences(const std::string &jsonString);
-        std::string toEscapeSequences(const std::string &utf8String);
+        std::string_view fromEscapeSequences(std::string_view jsonString);
+        std::string_view toEscapeSequences(std::string_view utf8String);
         // ================
         // PUBLIC VARIABLES
         // ================
@@ -48,15 +48,13 @@ namespace H4
         // ===============
         // PRIVATE METHODS
         // ===============
-        void initialiseTranslationMaps();
+        char16_t decodeUTF16(std::string_view hexDigits);
+        void appendUTF8(char32_t codePoint, std::string &utf8String);
+        char32_t decodeUTF8(const char *&current, const char *end);
         // =================
         // PRIVATE VARIABLES
         // =================
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> m_utf8Toutf16;
-        std::u16string m_utf16workBuffer;
-        std::string m_utf8workBuffer;
-        std::map<char, std::u16string> m_fromMap;
-        std::map<char, std::string> m_toMap;
+        bool m_rawUTF8;
     };
 } // namespace H4
 #endif /* JSONTRANSLATOR_HPP */
@@ -0,0 +1,362 @@
+#ifndef JVALUE_HPP
+#define JVALUE_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+//
+// JSON JNodes
+//
+#include "JNode.hpp"
+#include "JSONDocument.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    //
+    // Compact (16 byte) tagged JSON value. Holds a JNodeType tag plus either
+    // an inline scalar (integer/floating point/boolean), a small string of up
+    // to 14 bytes stored inline, or a pointer to a string or to a contiguous
+    // run of child values. Object children are stored as key/value pairs of
+    // JValues, in the order they were parsed; an object with at least
+    // kMinIndexedEntries entries also has an index of them sorted by key
+    // (stored after its children) so a key is found by binary search. As
+    // for a JNodeObject the last of any duplicate keys is the one found,
+    // although every entry is kept (and stringified). All out of line
+    // storage lives in the arena of the owning JValueDocument so JValues
+    // are trivially copyable and never free anything themselves.
+    // The read only accessors mirror those of the JNode types; JValues are
+    // immutable, so there is nothing like addEntry(), the non-const
+    // accessors, getEntries()/getArray(), freeze(), getText() (number text
+    // is not kept) or the packed numeric array accessors.
+    //
+    struct alignas(8) JValue
+    {
+    public:
+        // Longest string that is stored inline
+        static constexpr std::size_t kMaxInlineString = 14;
+        // Fewest object entries for which a sorted key index is built
+        static constexpr std::size_t kMinIndexedEntries = 16;
+        //
+        // Construction (used by the parser)
+        //
+        JValue() : JValue(JNodeType::null, 0)
+        {
+        }
+        static JValue makeBoolean(bool value)
+        {
+            JValue jValue(JNodeType::boolean, value ? 1 : 0);
+            return (jValue);
+        }
+        static JValue makeInteger(long long value)
+        {
+            JValue jValue(JNodeType::number, kInteger);
+            jValue.setPayload(value);
+            return (jValue);
+        }
+        static JValue makeFloatingPoint(double value)
+        {
+            JValue jValue(JNodeType::number, kFloatingPoint);
+            jValue.setPayload(value);
+            return (jValue);
+        }
+        static JValue makeNumber(const JNumeric &numeric)
+        {
+            switch (numeric.kind)
+            {
+            case JNumeric::Kind::integer:
+                return (makeInteger(numeric.integer));
+            case JNumeric::Kind::unsignedInteger:
+            {
+                JValue jValue(JNodeType::number, kUnsignedInteger);
+                jValue.setPayload(numeric.unsignedInteger);
+                return (jValue);
+            }
+            default:
+                return (makeFloatingPoint(numeric.floatingPoint));
+            }
+        }
+        static JValue makeString(std::string_view value, std::pmr::memory_resource *arena)
+        {
+            if (value.size() <= kMaxInlineString)
+            {
+                JValue jValue(JNodeType::string, kInlineString | (std::uint8_t)value.size());
+                std::memcpy(jValue.m_bytes, value.data(), value.size());
+                return (jValue);
+            }
+            char *string = static_cast<char *>(arena->allocate(value.size(), 1));
+            std::memcpy(string, value.data(), value.size());
+            JValue jValue(JNodeType::string, 0);
+            jValue.setSize(value.size());
+            jValue.setPayload(static_cast<const char *>(string));
+            return (jValue);
+        }
+        static JValue makeContainer(JNodeType nodeType, const JValue *children, std::size_t count, std::pmr::memory_resource *arena)
+        {
+            std::size_t entries = (nodeType == JNodeType::object) ? count / 2 : count;
+            bool indexed = (nodeType == JNodeType::object) && (entries >= kMinIndexedEntries);
+            JValue jValue(nodeType, indexed ? kSortedKeys : 0);
+            const JValue *contiguous = nullptr;
+            if (count > 0)
+            {
+                std::size_t indexSize = indexed ? entries * sizeof(std::uint32_t) : 0;
+                JValue *copy = static_cast<JValue *>(arena->allocate(count * sizeof(JValue) + indexSize, alignof(JValue)));
+                std::memcpy(static_cast<void *>(copy), children, count * sizeof(JValue));
+                contiguous = copy;
+                if (indexed)
+                {
+                    // Stable so that duplicate keys stay in parsed order
+                    std::uint32_t *index = reinterpret_cast<std::uint32_t *>(copy + count);
+                    for (std::uint32_t entry = 0; entry < entries; entry++)
+                    {
+                        index[entry] = entry;
+                    }
+                    std::stable_sort(index, index + entries, [copy](std::uint32_t lhs, std::uint32_t rhs)
+                                     { return (copy[lhs * 2].getString() < copy[rhs * 2].getString()); });
+                }
+            }
+            jValue.setSize(entries);
+            jValue.setPayload(contiguous);
+            return (jValue);
+        }
+        //
+        // Type
+        //
+        JNodeType getNodeType() const
+        {
+            return ((JNodeType)m_type);
+        }
+        bool isInteger() const
+        {
+            return ((m_type == JNodeType::number) && ((m_info == kInteger) || (m_info == kUnsignedInteger)));
+        }
+        //
+        // Object/Array
+        //
+        int size() const
+        {
+            if ((m_type == JNodeType::object) || (m_type == JNodeType::array))
+            {
+                return ((int)getSize());
+            }
+            return (0);
+        }
+        bool containsKey(std::string_view key) const
+        {
+            return (findEntry(key) != nullptr);
+        }
+        std::string_view getKey(int index) const
+        {
+            return (children()[index * 2].getString());
+        }
+        std::vector<std::string_view> getKeys() const
+        {
+            std::vector<std::string_view> keys;
+            if (m_type == JNodeType::object)
+            {
+                for (int index = 0; index < size(); index++)
+                {
+                    keys.push_back(getKey(index));
+                }
+            }
+            return (keys);
+        }
+        const JValue &operator[](std::string_view key) const
+        {
+            const JValue *entry = findEntry(key);
+            if (entry == nullptr)
+            {
+                throw std::runtime_error("Invalid key used to access object.");
+            }
+            return (*entry);
+        }
+        const JValue &operator[](int index) const
+        {
+            if ((m_type == JNodeType::object) && (index >= 0) && (index < size()))
+            {
+                return (children()[(index * 2) + 1]);
+            }
+            if ((m_type == JNodeType::array) && (index >= 0) && (index < size()))
+            {
+                return (children()[index]);
+            }
+            throw std::runtime_error("Invalid index used to access array.");
+        }
+        const JValue *begin() const
+        {
+            return ((m_type == JNodeType::array) ? children() : nullptr);
+        }
+        const JValue *end() const
+        {
+            return ((m_type == JNodeType::array) ? children() + getSize() : nullptr);
+        }
+        //
+        // Scalars
+        //
+        std::string_view getString() const
+        {
+            if (m_info & kInlineString)
+            {
+                return (std::string_view(m_bytes, m_info & ~kInlineString));
+            }
+            return (std::string_view(getPayload<const char *>(), getSize()));
+        }
+        JNumeric getNumeric() const
+        {
+            JNumeric numeric;
+            switch (m_info)
+            {
+            case kInteger:
+                numeric.kind = JNumeric::Kind::integer;
+                numeric.integer = getPayload<long long>();
+                break;
+            case kUnsignedInteger:
+                numeric.kind = JNumeric::Kind::unsignedInteger;
+                numeric.unsignedInteger = getPayload<unsigned long long>();
+                break;
+            default:
+                numeric.kind = JNumeric::Kind::floatingPoint;
+                numeric.floatingPoint = getPayload<double>();
+                break;
+            }
+            return (numeric);
+        }
+        std::string getNumber() const
+        {
+            return (getNumeric().toString());
+        }
+        // Same semantics as JNodeNumber: returns true only when the number is an integer
+        bool getInteger(long &longValue) const
+        {
+            return (getNumeric().getInteger(longValue));
+        }
+        bool getFloatingPoint(double &doubleValue) const
+        {
+            return (getNumeric().getFloatingPoint(doubleValue));
+        }
+        bool getBoolean() const
+        {
+            return (m_info != 0);
+        }
+        void *getNull() const
+        {
+            return (nullptr);
+        }
+
+    private:
+        // m_info values/flags
+        static constexpr std::uint8_t kInteger = 1;
+        static constexpr std::uint8_t kFloatingPoint = 2;
+        static constexpr std::uint8_t kUnsignedInteger = 3;
+        static constexpr std::uint8_t kInlineString = 0x80;
+        static constexpr std::uint8_t kSortedKeys = 1;
+        // Offsets into m_bytes of out of line size and payload
+        static constexpr std::size_t kSizeOffset = 2;
+        static constexpr std::size_t kPayloadOffset = 6;
+        JValue(JNodeType nodeType, std::uint8_t info) : m_type((std::uint8_t)nodeType), m_info(info)
+        {
+            std::memset(m_bytes, 0, sizeof(m_bytes));
+        }
+        std::uint32_t getSize() const
+        {
+            std::uint32_t size;
+            std::memcpy(&size, m_bytes + kSizeOffset, sizeof(size));
+            return (size);
+        }
+        void setSize(std::size_t size)
+        {
+            if (size > UINT32_MAX)
+            {
+                throw std::length_error("JSON value too large to be stored in a JValue.");
+            }
+            std::uint32_t size32 = (std::uint32_t)size;
+            std::memcpy(m_bytes + kSizeOffset, &size32, sizeof(size32));
+        }
+        template <typename T>
+        T getPayload() const
+        {
+            T payload;
+            std::memcpy(&payload, m_bytes + kPayloadOffset, sizeof(T));
+            return (payload);
+        }
+        template <typename T>
+        void setPayload(T payload)
+        {
+            static_assert(sizeof(T) == 8);
+            std::memcpy(m_bytes + kPayloadOffset, &payload, sizeof(T));
+        }
+        const JValue *children() const
+        {
+            return (getPayload<const JValue *>());
+        }
+        // Value of last entry with a key (nullptr if none)
+        const JValue *findEntry(std::string_view key) const
+        {
+            if (m_type != JNodeType::object)
+            {
+                return (nullptr);
+            }
+            const JValue *entries = children();
+            if (m_info & kSortedKeys)
+            {
+                const std::uint32_t *index = reinterpret_cast<const std::uint32_t *>(entries + (getSize() * 2));
+                const std::uint32_t *after = std::upper_bound(index, index + getSize(), key, [entries](std::string_view wanted, std::uint32_t entry)
+                                                              { return (wanted < entries[entry * 2].getString()); });
+                if ((after != index) && (entries[after[-1] * 2].getString() == key))
+                {
+                    return (&entries[(after[-1] * 2) + 1]);
+                }
+                return (nullptr);
+            }
+            for (std::uint32_t entry = getSize(); entry-- > 0;)
+            {
+                if (entries[entry * 2].getString() == key)
+                {
+                    return (&entries[(entry * 2) + 1]);
+                }
+            }
+            return (nullptr);
+        }
+        std::uint8_t m_type;
+        std::uint8_t m_info;
+        char m_bytes[14];
+    };
+    static_assert(sizeof(JValue) == 16, "JValue should be 16 bytes.");
+    //
+    // A tree of JValues together with the arena that holds all of its
+    // strings and child value arrays.
+    //
+    class JValueDocument
+    {
+    public:
+        JValueDocument(std::size_t initialArenaSize = JSONDocument::kMinimumArenaSize)
+            : m_arena(std::make_unique<std::pmr::monotonic_buffer_resource>(std::max(initialArenaSize, JSONDocument::kMinimumArenaSize)))
+        {
+        }
+        const JValue &root() const
+        {
+            return (m_root);
+        }
+        std::pmr::memory_resource *arena()
+        {
+            return (m_arena.get());
+        }
+
+    private:
+        friend class JSON;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> m_arena;
+        JValue m_root;
+    };
+} // namespace H4
+#endif /* JVALUE_HPP */
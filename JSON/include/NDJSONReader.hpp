@@ -0,0 +1,83 @@
+#ifndef NDJSONREADER_HPP
+#define NDJSONREADER_HPP
+//
+// C++ STL
+//
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+//
+// JSON
+//
+#include "JSON.hpp"
+// =========
+// NAMESPACE
+// =========
+namespace H4
+{
+    // ================
+    // CLASS DEFINITION
+    // ================
+    class NDJSONReader
+    {
+    public:
+        // ==========================
+        // PUBLIC TYPES AND CONSTANTS
+        // ==========================
+        //
+        // A parsed record (line); jNode is null and error set if the
+        // line failed to parse.
+        //
+        struct Record
+        {
+            std::size_t offset = 0;
+            std::unique_ptr<JNode> jNode;
+            std::string error;
+        };
+        using RecordCallback = std::function<void(Record &record)>;
+        static constexpr std::size_t kDefaultChunkSize = 1024 * 1024;
+        // ============
+        // CONSTRUCTORS
+        // ============
+        NDJSONReader(unsigned threadCount = 0, bool ordered = true, std::size_t chunkSize = kDefaultChunkSize);
+        NDJSONReader(const JSON &json, unsigned threadCount = 0, bool ordered = true, std::size_t chunkSize = kDefaultChunkSize);
+        // ==========
+        // DESTRUCTOR
+        // ==========
+        // ==============
+        // PUBLIC METHODS
+        // ==============
+        std::size_t parseBuffer(std::string_view ndjsonBuffer, const RecordCallback &callback);
+        std::size_t parseFile(const std::string &sourceFileName, const RecordCallback &callback);
+        // ================
+        // PUBLIC VARIABLES
+        // ================
+    private:
+        // ===========================
+        // PRIVATE TYPES AND CONSTANTS
+        // ===========================
+        // Chunks being parsed and their results (NDJSONReader.cpp)
+        struct ChunkQueue;
+        // ===========================================
+        // DISABLED CONSTRUCTORS/DESTRUCTORS/OPERATORS
+        // ===========================================
+        // ===============
+        // PRIVATE METHODS
+        // ===============
+        std::vector<std::string_view> splitIntoChunks(std::string_view ndjsonBuffer);
+        static std::unique_ptr<JNode> parseLine(JSON &json, std::string_view line);
+        static void parseChunk(JSON &json, std::string_view chunk, std::size_t chunkOffset, std::vector<Record> &records);
+        static void parseChunks(const JSON &settings, ChunkQueue &queue, bool ordered);
+        // =================
+        // PRIVATE VARIABLES
+        // =================
+        // Settings (translator, nesting depth etc.) records are parsed with
+        JSON m_json;
+        unsigned m_threadCount;
+        bool m_ordered;
+        std::size_t m_chunkSize;
+    };
+} // namespace H4
+#endif /* NDJSONREADER_HPP */
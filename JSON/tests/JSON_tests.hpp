@@ -8,9 +8,15 @@
 // Class under test includes
 // =========================
 #include "JSON.hpp"
+#include "JSONDocument.hpp"
 #include "JSONSources.hpp"
 #include "JSONDestinations.hpp"
 #include "JSONTranslator.hpp"
+#include "JSONReader.hpp"
+#include "JSONPushParser.hpp"
+#include "NDJSONReader.hpp"
+#include "JSONTape.hpp"
+#include "JSONColumns.hpp"
 // ============
 // STL includes
 // ============
@@ -19,6 +25,7 @@
 #include <iterator>
 #include <string>
 #include <algorithm>
+#include <thread>
 // ===================
 // Unit test constants
 // ===================
@@ -141,6 +141,122 @@ TEST_CASE("Creation and use of ISource (Buffer) interface (buffer contains file
     REQUIRE(source.currentByte() == (char)255); // eof
   }
 }
+TEST_CASE("Creation and use of SpanSource (buffer contains file testfile001.json).", "[JSON][Parse][SpanSource]")
+{
+  std::string buffer = readJSONFromFile(kSIngleJSONFile);
+  SECTION("Create SpanSource with testfile001.json and that it is positioned on the correct first character", "[JSON][Parse][SpanSource]")
+  {
+    SpanSource source = SpanSource(buffer);
+    REQUIRE_FALSE(!source.bytesToParse());
+    REQUIRE((char)source.currentByte() == '{');
+  }
+  SECTION("Create SpanSource with testfile001.json and then check moveToNextByte positions to correct next character", "[JSON][Parse][SpanSource]")
+  {
+    SpanSource source = SpanSource(buffer);
+    source.moveToNextByte();
+    REQUIRE_FALSE(!source.bytesToParse());
+    REQUIRE((char)source.currentByte() == '\n');
+  }
+  SECTION("Create SpanSource with testfile001.json move past last character, check it and the bytes moved.", "[JSON][Parse][SpanSource]")
+  {
+    SpanSource source = SpanSource(buffer);
+    long length = 0;
+    while (source.bytesToParse())
+    {
+      source.moveToNextByte();
+      length++;
+    }
+    REQUIRE(length == 583);                     // eof
+    REQUIRE(source.currentByte() == (char)255); // eof
+  }
+  SECTION("Parse testfile001.json from a buffer (SpanSource) and check the result is the same as for a BufferSource.", "[JSON][Parse][SpanSource]")
+  {
+    JSON json;
+    BufferSource source = BufferSource(buffer);
+    REQUIRE(json.stringifyToBuffer(json.parseBuffer(buffer)) == json.stringifyToBuffer(json.parse(source)));
+  }
+}
+TEST_CASE("Creation and use of IndexedSource.", "[JSON][Parse][IndexedSource]")
+{
+  JSON json;
+  SECTION("Create IndexedSource with testfile001.json and check whitespace skipped to the first key.", "[JSON][Parse][IndexedSource]")
+  {
+    std::string buffer = readJSONFromFile(kSIngleJSONFile);
+    IndexedSource source(buffer);
+    REQUIRE((char)source.currentByte() == '{');
+    source.moveToNextByte();
+    source.skipWhiteSpace();
+    REQUIRE((char)source.currentByte() == '"');
+  }
+  SECTION("Create IndexedSource and check a string with escapes is skipped in one step.", "[JSON][Parse][IndexedSource]")
+  {
+    IndexedSource source("\"a\\\"b\\\\\"   true");
+    std::string_view contents;
+    REQUIRE_FALSE(!source.skipString(contents));
+    REQUIRE(contents == "a\\\"b\\\\");
+    source.skipWhiteSpace();
+    REQUIRE((char)source.currentByte() == 't');
+  }
+  SECTION("Parse escapes, strings and whitespace crossing 64 byte blocks and check the result is the same as for a BufferSource.", "[JSON][Parse][IndexedSource]")
+  {
+    for (std::size_t padding = 0; padding < 70; padding++)
+    {
+      std::string buffer = "[" + std::string(padding, ' ') + "\"" + std::string(padding % 7, 'x') + "\\\\\\\"" +
+                           std::string(padding % 5, '\t') + "\\\\\" , \"{[:,]}\\u0041\",\n" + std::string(padding, '\n') + "-1.5e3 ," +
+                           std::string(padding % 3, ' ') + "{\"key\\\\\":null}]  ";
+      BufferSource source(buffer);
+      REQUIRE(json.stringifyToBuffer(json.parseBuffer(buffer)) == json.stringifyToBuffer(json.parse(source)));
+    }
+  }
+  SECTION("Create IndexedSource too large to be indexed and check whitespace and strings are still skipped.", "[JSON][Parse][IndexedSource]")
+  {
+    IndexedSource source("  \"a\\\"b\\\\\"   true", 0);
+    REQUIRE_FALSE(source.isIndexed());
+    source.skipWhiteSpace();
+    std::string_view contents;
+    REQUIRE_FALSE(!source.skipString(contents));
+    REQUIRE(contents == "a\\\"b\\\\");
+    source.skipWhiteSpace();
+    REQUIRE((char)source.currentByte() == 't');
+    IndexedSource unterminated("\"abc\\\"", 0);
+    REQUIRE_FALSE(unterminated.skipString(contents));
+  }
+  SECTION("Parse unterminated string from an IndexedSource.", "[JSON][Parse][IndexedSource][Exception]")
+  {
+    REQUIRE_THROWS_AS(json.parseBuffer("[\"abc\\\"]"), JSON::SyntaxError);
+  }
+}
+TEST_CASE("Creation and use of MappedFileSource.", "[JSON][Parse][MappedFileSource]")
+{
+  SECTION("Create MappedFileSource with non existant file.", "[JSON][Parse][MappedFileSource][Exception]")
+  {
+    REQUIRE_THROWS_AS(MappedFileSource(kNonExistantJSONFile), std::runtime_error);
+    REQUIRE_THROWS_WITH(MappedFileSource(kNonExistantJSONFile), "JSON file input stream failed to open or does not exist.");
+  }
+  SECTION("Create MappedFileSource with testfile001.json and that it is positioned on the correct first character", "[JSON][Parse][MappedFileSource]")
+  {
+    MappedFileSource source(kSIngleJSONFile);
+    REQUIRE_FALSE(!source.bytesToParse());
+    REQUIRE((char)source.currentByte() == '{');
+  }
+  SECTION("Create MappedFileSource with testfile001.json move past last character, check it and the bytes moved.", "[JSON][Parse][MappedFileSource]")
+  {
+    MappedFileSource source(kSIngleJSONFile);
+    long length = 0;
+    while (source.bytesToParse())
+    {
+      source.moveToNextByte();
+      length++;
+    }
+    REQUIRE(length == 583);                     // eof
+    REQUIRE(source.currentByte() == (char)255); // eof
+  }
+  SECTION("Parse testfile001.json with parseFile and check the result is the same as parsing it from a buffer.", "[JSON][Parse][MappedFileSource]")
+  {
+    JSON json;
+    REQUIRE(json.stringifyToBuffer(json.parseFile(kSIngleJSONFile)) == json.stringifyToBuffer(json.parseBuffer(readJSONFromFile(kSIngleJSONFile))));
+  }
+}
 TEST_CASE("Creation and use of IDestination (Buffer) interface.", "[JSON][Parse][ISource]")
 {
   SECTION("Create BufferDesination.", "[JSON][Stringify][IDesination]")
@@ -165,6 +281,28 @@ TEST_CASE("Creation and use of IDestination (Buffer) interface.", "[JSON][Parse]
     REQUIRE(buffer.getBuffer().size() == 5);
     REQUIRE(buffer.getBuffer() == ("65767"));
   }
+  SECTION("Create BufferDestination, add single bytes and check result.", "[JSON][Stringify][IDesination]")
+  {
+    BufferDestination buffer;
+    buffer.addByte('[');
+    buffer.addBytes("1");
+    buffer.addByte(']');
+    REQUIRE(buffer.getBuffer() == ("[1]"));
+  }
+  SECTION("Stringify to a destination that only implements addBytes() and check result.", "[JSON][Stringify][IDesination]")
+  {
+    struct BytesDestination : JSON::IDestination
+    {
+      void addBytes(std::string_view bytes) override
+      {
+        m_buffer.append(bytes.data(), bytes.size());
+      }
+      std::string m_buffer;
+    } destination;
+    JSON json;
+    json.stringify(*json.parseBuffer("{\"a\" : [1, \"two\", true]}"), destination);
+    REQUIRE(destination.m_buffer == "{\"a\":[1,\"two\",true]}");
+  }
 }
 TEST_CASE("Creation and use of IDestination (File) interface.", "[JSON][Parse][ISource]")
 {
@@ -192,6 +330,7 @@ TEST_CASE("Creation and use of IDestination (File) interface.", "[JSON][Parse][I
     std::filesystem::remove(kGeneratedJSONFile);
     FileDestination file(kGeneratedJSONFile);
     file.addBytes("t");
+    file.flush();
     std::filesystem::path filePath(kGeneratedJSONFile);
     REQUIRE(std::filesystem::file_size(filePath) == 1);
   }
@@ -200,11 +339,47 @@ TEST_CASE("Creation and use of IDestination (File) interface.", "[JSON][Parse][I
     std::filesystem::remove(kGeneratedJSONFile);
     FileDestination file(kGeneratedJSONFile);
     file.addBytes("65767");
+    file.flush();
     std::filesystem::path filePath(kGeneratedJSONFile);
     REQUIRE(std::filesystem::file_size(filePath) == 5);
     std::string expected = readJSONFromFile(kGeneratedJSONFile);
     REQUIRE(expected == "65767");
   }
+  SECTION("Create FileDestination, add bytes and check they are only written when flushed or the destination is destroyed.", "[JSON][Stringify][IDesination]")
+  {
+    std::filesystem::remove(kGeneratedJSONFile);
+    {
+      FileDestination file(kGeneratedJSONFile);
+      file.addByte('[');
+      file.addBytes("65767");
+      REQUIRE(std::filesystem::file_size(kGeneratedJSONFile) == 0);
+      file.addByte(']');
+    }
+    REQUIRE(readJSONFromFile(kGeneratedJSONFile) == "[65767]");
+  }
+  SECTION("Create FileDestination on a full device and check the failed write is reported.", "[JSON][Stringify][IDesination][Exception]")
+  {
+    if (std::filesystem::exists("/dev/full"))
+    {
+      FileDestination file("/dev/full");
+      file.addBytes("65767");
+      REQUIRE_THROWS_WITH(file.flush(), "JSON file output stream failed to write.");
+      JSON json;
+      REQUIRE_THROWS_WITH(json.stringifyToFile(*json.parseBuffer("[65767]"), "/dev/full"), "JSON file output stream failed to write.");
+    }
+  }
+  SECTION("Create FileDestination, add more bytes than its block buffer holds and check result.", "[JSON][Stringify][IDesination]")
+  {
+    std::filesystem::remove(kGeneratedJSONFile);
+    std::string expected = std::string(FileDestination::kBlockSize - 1, 'a') + std::string(FileDestination::kBlockSize + 10, 'b') + "c";
+    {
+      FileDestination file(kGeneratedJSONFile);
+      file.addBytes(std::string(FileDestination::kBlockSize - 1, 'a'));
+      file.addBytes(std::string(FileDestination::kBlockSize + 10, 'b'));
+      file.addByte('c');
+    }
+    REQUIRE(readJSONFromFile(kGeneratedJSONFile) == expected);
+  }
 }
 // Implement these for JSON
 TEST_CASE("Use of JNode indexing operators", "[JSON][JNode][Index]")
@@ -246,6 +421,41 @@ TEST_CASE("Use of JNode indexing operators", "[JSON][JNode][Index]")
     REQUIRE_THROWS_WITH((*jNode)[3].nodeType == JNodeType::array, "Invalid index used to access array.");
   }
 }
+TEST_CASE("Use of JNodeObject entry map", "[JSON][JNode][JNodeObject]")
+{
+  JSON json;
+  std::unique_ptr<JNode> jNode;
+  SECTION("Parse a wide object and check every key can be found and key order is kept.", "[JSON][JNode][JNodeObject]")
+  {
+    std::string expected = "{";
+    for (int field = 0; field < 500; field++)
+    {
+      expected += ((field > 0) ? ",\"field" : "\"field") + std::to_string(field) + "\":" + std::to_string(field);
+    }
+    expected += "}";
+    jNode = json.parseBuffer(expected);
+    REQUIRE(JNodeRef<JNodeObject>(*jNode).size() == 500);
+    for (int field = 0; field < 500; field++)
+    {
+      REQUIRE(std::string_view(JNodeRef<JNodeNumber>((*jNode)["field" + std::to_string(field)]).getNumber()) == std::to_string(field));
+    }
+    REQUIRE_FALSE(JNodeRef<JNodeObject>(*jNode).containsKey("field500"));
+    REQUIRE(JNodeRef<JNodeObject>(*jNode).getKeys()[499] == "field499");
+    REQUIRE(json.stringifyToBuffer(std::move(jNode)) == expected);
+  }
+  SECTION("Parse object with a duplicate key and check the last value is kept in the first position.", "[JSON][JNode][JNodeObject]")
+  {
+    jNode = json.parseBuffer("{\"City\":\"Southampton\",\"Population\":500000,\"City\":\"London\"}");
+    REQUIRE(JNodeRef<JNodeObject>(*jNode).size() == 2);
+    REQUIRE(json.stringifyToBuffer(std::move(jNode)) == "{\"City\":\"London\",\"Population\":500000}");
+  }
+  SECTION("Check getEntry of a missing key returns nullptr and does not add an entry.", "[JSON][JNode][JNodeObject]")
+  {
+    jNode = json.parseBuffer("{\"City\":\"Southampton\",\"Population\":500000}");
+    REQUIRE(JNodeRef<JNodeObject>(*jNode).getEntry("Cityy") == nullptr);
+    REQUIRE(JNodeRef<JNodeObject>(*jNode).size() == 2);
+  }
+}
 TEST_CASE("Check JNode reference functions work.", "[JSON][JNode][Reference]")
 {
   JSON json;
@@ -257,7 +467,7 @@ TEST_CASE("Check JNode reference functions work.", "[JSON][JNode][Reference]")
   }
   SECTION("String reference.", "[JSON][JNode][Reference]")
   {
-    jNode = json.parseBuffer("0123456789");
+    jNode = json.parseBuffer("\"0123456789\"");
     REQUIRE(JNodeRef<JNodeString>((*jNode)).getString() == "0123456789");
   }
   SECTION("Array reference.", "[JSON][JNode][Reference]")
@@ -273,6 +483,111 @@ TEST_CASE("Check JNode reference functions work.", "[JSON][JNode][Reference]")
     REQUIRE(JNodeRef<JNodeString>((*jNode)["City"]).getString() == "Southampton");
   }
 }
+TEST_CASE("Parse into compact JValues and check their values using the JNode style accessors.", "[JSON][JValue]")
+{
+  JSON json;
+  SECTION("Check a JValue is 16 bytes.", "[JSON][JValue]")
+  {
+    REQUIRE(sizeof(JValue) == 16);
+  }
+  SECTION("Parse an array [\"Dog\",1964,true,null] and check its components.", "[JSON][JValue]")
+  {
+    JValueDocument document = json.parseBufferToJValues("[\"Dog\",1964,true,null]");
+    const JValue &jValue = document.root();
+    REQUIRE(jValue.getNodeType() == JNodeType::array);
+    REQUIRE(jValue.size() == 4);
+    REQUIRE(jValue[0].getNodeType() == JNodeType::string);
+    REQUIRE(jValue[1].getNodeType() == JNodeType::number);
+    REQUIRE(jValue[2].getNodeType() == JNodeType::boolean);
+    REQUIRE(jValue[3].getNodeType() == JNodeType::null);
+    REQUIRE(jValue[0].getString() == "Dog");
+    REQUIRE(jValue[1].getNumber() == "1964");
+    REQUIRE(jValue[2].getBoolean() == true);
+    REQUIRE(jValue[3].getNull() == nullptr);
+  }
+  SECTION("Parse object {\"City\":\"Southampton\",\"Population\":500000} and check its components.", "[JSON][JValue]")
+  {
+    JValueDocument document = json.parseBufferToJValues("{\"City\":\"Southampton\",\"Population\":500000}");
+    const JValue &jValue = document.root();
+    REQUIRE(jValue.getNodeType() == JNodeType::object);
+    REQUIRE(jValue.size() == 2);
+    REQUIRE(jValue.containsKey("City"));
+    REQUIRE(jValue.containsKey("Population"));
+    REQUIRE(jValue.getKeys() == std::vector<std::string_view>{"City", "Population"});
+    REQUIRE(jValue["City"].getString() == "Southampton");
+    REQUIRE(jValue["Population"].getNumber() == "500000");
+  }
+  SECTION("Parse strings either side of the inline limit and check their values.", "[JSON][JValue]")
+  {
+    JValueDocument document = json.parseBufferToJValues("[\"12345678901234\",\"123456789012345\",\"\"]");
+    REQUIRE(document.root()[0].getString() == "12345678901234");
+    REQUIRE(document.root()[1].getString() == "123456789012345");
+    REQUIRE(document.root()[2].getString() == "");
+  }
+  SECTION("Parse numbers and check integer and floating point conversion.", "[JSON][JValue]")
+  {
+    JValueDocument document = json.parseBufferToJValues("[78989,678.8990,-45]");
+    long longValue;
+    double doubleValue;
+    REQUIRE_FALSE(!document.root()[0].getInteger(longValue));
+    REQUIRE(longValue == 78989);
+    REQUIRE_FALSE(document.root()[1].getInteger(longValue));
+    REQUIRE_FALSE(!document.root()[1].getFloatingPoint(doubleValue));
+    REQUIRE(doubleValue == 678.8990);
+    REQUIRE_FALSE(!document.root()[2].getInteger(longValue));
+    REQUIRE(longValue == -45);
+  }
+  SECTION("Parse list with embedded dictionary and check stringify gives back the same JSON.", "[JSON][JValue]")
+  {
+    std::string expected = "[777,{\"City\":\"Southampton\",\"Population\":500000},\"apples\"]";
+    REQUIRE(json.stringifyToBuffer(json.parseBufferToJValues(expected)) == expected);
+  }
+  SECTION("Check invalid key and index generate exceptions.", "[JSON][JValue][Exception]")
+  {
+    JValueDocument document = json.parseBufferToJValues("{\"City\":\"Southampton\",\"Population\":500000}");
+    REQUIRE_THROWS_WITH(document.root()["Cityy"], "Invalid key used to access object.");
+    REQUIRE_THROWS_WITH(document.root()["City"][0], "Invalid index used to access array.");
+  }
+  SECTION("Parse with a syntax error.", "[JSON][JValue][Exception]")
+  {
+    REQUIRE_THROWS_AS(json.parseBufferToJValues("{ \"one\" : [1, 2, 3], \"two\" : 18987u3 }"), JSON::SyntaxError);
+  }
+  SECTION("Look up keys in objects either side of the sorted index limit (with duplicates).", "[JSON][JValue]")
+  {
+    // Three duplicate keys are added so with 12 an object is not indexed and with 13 it is
+    for (std::size_t entries : {JValue::kMinIndexedEntries - 4, JValue::kMinIndexedEntries - 3, std::size_t(100)})
+    {
+      std::string jsonBuffer{"{"};
+      for (std::size_t entry = 0; entry < entries; entry++)
+      {
+        // Keys in neither sorted nor reverse order
+        jsonBuffer += "\"key" + std::to_string((entry * 7) % entries) + "\":" + std::to_string(entry) + ",";
+      }
+      jsonBuffer += "\"key3\":-1,\"key0\":-2,\"key11\":-3}";
+      JValueDocument document = json.parseBufferToJValues(jsonBuffer);
+      const JValue &jValue = document.root();
+      REQUIRE(jValue.size() == (int)entries + 3);
+      REQUIRE(jValue.getKey(0) == "key0");
+      REQUIRE(jValue.getKey(1) == "key7");
+      for (std::size_t entry = 0; entry < entries; entry++)
+      {
+        std::string key = "key" + std::to_string((entry * 7) % entries);
+        REQUIRE(jValue.containsKey(key));
+        if ((key != "key3") && (key != "key0") && (key != "key11"))
+        {
+          REQUIRE(jValue[key].getNumeric().integer == (long long)entry);
+        }
+      }
+      REQUIRE(jValue["key3"].getNumeric().integer == -1);
+      REQUIRE(jValue["key0"].getNumeric().integer == -2);
+      REQUIRE(jValue["key11"].getNumeric().integer == -3);
+      REQUIRE_FALSE(jValue.containsKey("key"));
+      REQUIRE_FALSE(jValue.containsKey("key" + std::to_string(entries)));
+      REQUIRE_FALSE(jValue.containsKey("zzz"));
+      REQUIRE(json.stringifyToBuffer(document) == jsonBuffer);
+    }
+  }
+}
 TEST_CASE("Check JNodeNumber number conversion", "[JSON][JNode][JNodeNumber]")
 {
   JSON json;
@@ -317,6 +632,39 @@ TEST_CASE("Check JNodeNumber number conversion", "[JSON][JNode][JNodeNumber]")
     REQUIRE_THROWS_AS(jNode = json.parseBuffer("78.5454.545"), JSON::SyntaxError);
     REQUIRE_THROWS_WITH(jNode = json.parseBuffer("78.5454.545"), "JSON syntax error detected.");
   }
+  SECTION("Check numbers not allowed by the JSON grammar", "[JSON][JNode][JNodeNumber][Exception]")
+  {
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("0123"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("+123"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("-"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("12."), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer(".5"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("1e"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(jNode = json.parseBuffer("[1-2]"), JSON::SyntaxError);
+  }
+  SECTION("Check number stored natively as integer, unsigned integer or floating point", "[JSON][JNode][JNodeNumber]")
+  {
+    jNode = json.parseBuffer("[-9223372036854775808,18446744073709551615,1e400,-0.0]");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[0]).getNumeric().kind == JNumeric::Kind::integer);
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[0]).getNumeric().integer == LLONG_MIN);
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumeric().kind == JNumeric::Kind::unsignedInteger);
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumeric().unsignedInteger == ULLONG_MAX);
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumber() == "18446744073709551615");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[2]).getNumeric().kind == JNumeric::Kind::floatingPoint);
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[2]).getNumber() == "1e400");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[3]).getNumber() == "-0");
+  }
+  SECTION("Check number text kept when asked for", "[JSON][JNode][JNodeNumber]")
+  {
+    json.keepNumberText(true);
+    jNode = json.parseBuffer("[1.50,2E3]");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[0]).getNumber() == "1.50");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumber() == "2E3");
+    json.keepNumberText(false);
+    jNode = json.parseBuffer("[1.50,2E3]");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[0]).getNumber() == "1.5");
+    REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumber() == "2000");
+  }
 }
 TEST_CASE("Check translation of surrogate pairs", "[JSON][DefaultTranslator]")
 {
@@ -345,8 +693,68 @@ TEST_CASE("Check translation of surrogate pairs", "[JSON][DefaultTranslator]")
     REQUIRE_THROWS_AS(translator.fromEscapeSequences("Begin \\uDD1E End"), JSON::SyntaxError);
     REQUIRE_THROWS_WITH(translator.fromEscapeSequences("Begin \\uDD1E End"), "JSON syntax error detected.");
   }
+  SECTION("Translate from escape sequences string without escapes and check it is returned as is", "[JSON][DefaultTranslator]")
+  {
+    std::string_view noEscapes = "Begin \xE2\x82\xAC End";
+    REQUIRE(translator.fromEscapeSequences(noEscapes).data() == noEscapes.data());
+    REQUIRE(translator.fromEscapeSequences(noEscapes) == "Begin \u20AC End");
+  }
+  SECTION("Translate from escape sequences 'Begin \\u0041\\u00e9\\u20AC\\t\\\"\\\\\\/ End' and check value decoded to UTF-8", "[JSON][DefaultTranslator]")
+  {
+    REQUIRE(translator.fromEscapeSequences("Begin \\u0041\\u00e9\\u20AC\\t\\\"\\\\\\/ End") == "Begin A\u00E9\u20AC\t\"\\/ End");
+  }
+  SECTION("Translate from escape sequences with invalid escapes then expect exception", "[JSON][DefaultTranslator][Exception]")
+  {
+    REQUIRE_THROWS_AS(translator.fromEscapeSequences("Begin \\u00G1 End"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(translator.fromEscapeSequences("Begin \\u00"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(translator.fromEscapeSequences("Begin \\x End"), JSON::SyntaxError);
+    REQUIRE_THROWS_AS(translator.fromEscapeSequences("Begin \\"), JSON::SyntaxError);
+  }
   SECTION("Translate to escape sequences valid surrogate pair 'Begin \\uD834\\uDD1E End' and check value", "[JSON][DefaultTranslator]")
   {
     REQUIRE(translator.toEscapeSequences("Begin \U0001D11E End") == "Begin \\uD834\\uDD1E End");
   }
+  SECTION("Translate to escape sequences string needing none and check it is returned as is", "[JSON][DefaultTranslator]")
+  {
+    std::string_view noEscapes = "Begin no escapes needed here End";
+    REQUIRE(translator.toEscapeSequences(noEscapes).data() == noEscapes.data());
+  }
+  SECTION("Translate to escape sequences string with invalid UTF-8 then expect exception", "[JSON][DefaultTranslator][Exception]")
+  {
+    REQUIRE_THROWS_AS(translator.toEscapeSequences("Begin \xC3 End"), std::invalid_argument);
+    REQUIRE_THROWS_AS(translator.toEscapeSequences("Begin \xC0\xAF End"), std::invalid_argument);
+  }
+}
+TEST_CASE("Use of a custom translator that returns views of one reused buffer", "[JSON][Translator]")
+{
+  // Every translation overwrites the last so anything that kept a view of
+  // a translated key or string (rather than copying it) would be corrupted
+  struct ReusedBufferTranslator : JSON::ITranslator
+  {
+    std::string_view fromEscapeSequences(std::string_view jsonString) override
+    {
+      m_buffer.assign(m_translator.fromEscapeSequences(jsonString));
+      return (m_buffer);
+    }
+    std::string_view toEscapeSequences(std::string_view utf8String) override
+    {
+      m_buffer.assign(m_translator.toEscapeSequences(utf8String));
+      return (m_buffer);
+    }
+    JSONTranslator m_translator;
+    std::string m_buffer;
+  } translator;
+  JSON json(&translator);
+  std::string jsonBuffer{"{\"k\\u0041\":\"v\\u0042\",\"list\":[\"x\\t\",{\"inner\":\"y\"}],\"last\":\"z\"}"};
+  SECTION("Parse and stringify through each path and check keys and strings are intact", "[JSON][Translator]")
+  {
+    std::string expected{"{\"kA\":\"vB\",\"list\":[\"x\\t\",{\"inner\":\"y\"}],\"last\":\"z\"}"};
+    REQUIRE(json.stringifyToBuffer(json.parseBuffer(jsonBuffer)) == expected);
+    REQUIRE(json.stringifyToBuffer(json.parseBufferToJValues(jsonBuffer)) == expected);
+    REQUIRE(json.stringifyToBuffer(json.parseBufferLazy(jsonBuffer)) == expected);
+    REQUIRE(json.stringifyToBuffer(std::move(json.extractFromBuffer(jsonBuffer, {"/list/1"})[0])) == "{\"inner\":\"y\"}");
+    JSONPushParser pushParser(&translator);
+    pushParser.feed(jsonBuffer);
+    REQUIRE(json.stringifyToBuffer(pushParser.getRoot()) == expected);
+  }
 }
\ No newline at end of file
@@ -13,6 +13,76 @@
 // =======================
 using namespace H4;
 // ==========
+// Test handler
+// ==========
+//
+// Parse event handler that rebuilds the JSON (without whitespace).
+//
+class RebuildHandler : public JSON::IHandler
+{
+public:
+    void onObjectStart() override
+    {
+        addValue("{");
+        m_firstEntry.push_back(true);
+    }
+    void onObjectEnd() override
+    {
+        m_firstEntry.pop_back();
+        m_json += "}";
+    }
+    void onArrayStart() override
+    {
+        addValue("[");
+        m_firstEntry.push_back(true);
+    }
+    void onArrayEnd() override
+    {
+        m_firstEntry.pop_back();
+        m_json += "]";
+    }
+    void onKey(std::string_view key) override
+    {
+        addValue("\"" + std::string(m_translator.toEscapeSequences(key)) + "\":");
+        m_afterKey = true;
+    }
+    void onString(std::string_view string) override
+    {
+        addValue("\"" + std::string(m_translator.toEscapeSequences(string)) + "\"");
+    }
+    void onNumber(const JNumeric &numeric, std::string_view /*text*/) override
+    {
+        addValue(numeric.toString());
+    }
+    void onBoolean(bool boolean) override
+    {
+        addValue(boolean ? "true" : "false");
+    }
+    void onNull() override
+    {
+        addValue("null");
+    }
+    std::string m_json;
+
+private:
+    void addValue(const std::string &value)
+    {
+        if (!m_afterKey && !m_firstEntry.empty())
+        {
+            if (!m_firstEntry.back())
+            {
+                m_json += ",";
+            }
+            m_firstEntry.back() = false;
+        }
+        m_afterKey = false;
+        m_json += value;
+    }
+    JSONTranslator m_translator;
+    std::vector<bool> m_firstEntry;
+    bool m_afterKey = false;
+};
+// ==========
 // Test cases
 // ==========
 TEST_CASE("Creation and use of JSON object for parse of simple types (number, string, boolean, null) ", "[JSON][Parse]")
@@ -220,6 +290,1159 @@ TEST_CASE("Creation and use of JSON object for parse of a list of example JSON f
         std::unique_ptr<JNode> jNode = json.parseFile(testFile);
         REQUIRE(jNode->nodeType == JNodeType::object);
     }
+    SECTION("Parse from file into compact JValues", "[JSON][Parse][JValue]")
+    {
+        JValueDocument document = json.parseFileToJValues(testFile);
+        REQUIRE(document.root().getNodeType() == JNodeType::object);
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer(json.stringifyToBuffer(document))) == json.stringifyToBuffer(json.parseFile(testFile)));
+    }
+}
+TEST_CASE("Creation and use of JSON object for parse raising events on a handler.", "[JSON][Parse][IHandler]")
+{
+    JSON json;
+    SECTION("Parse each example JSON file from a buffer with events and check rebuilt JSON is the same as stringified JNodes", "[JSON][Parse][IHandler]")
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            std::string jsonFileBuffer = readJSONFromFile(testFile);
+            RebuildHandler handler;
+            json.parseBuffer(jsonFileBuffer, handler);
+            REQUIRE(handler.m_json == json.stringifyToBuffer(json.parseBuffer(jsonFileBuffer)));
+        }
+    }
+    SECTION("Parse example JSON file directly with events and check rebuilt JSON is the same as stringified JNodes", "[JSON][Parse][IHandler]")
+    {
+        RebuildHandler handler;
+        json.parseFile("./testData/testfile002.json", handler);
+        REQUIRE(handler.m_json == json.stringifyToBuffer(json.parseFile("./testData/testfile002.json")));
+    }
+    SECTION("Parse from an ISource with events and check number text and values passed", "[JSON][Parse][IHandler]")
+    {
+        struct NumberHandler : JSON::IHandler
+        {
+            void onNumber(const JNumeric &numeric, std::string_view text) override
+            {
+                double value;
+                numeric.getFloatingPoint(value);
+                total += value;
+                texts += std::string(text) + ";";
+            }
+            double total = 0;
+            std::string texts;
+        } handler;
+        BufferSource source("{\"a\" : [1, 2.5e1, -3], \"b\" : {\"c\" : 0.5}}");
+        json.parse(source, handler);
+        REQUIRE(handler.total == 23.5);
+        REQUIRE(handler.texts == "1;2.5e1;-3;0.5;");
+    }
+    SECTION("Parse with events and a syntax error", "[JSON][Parse][IHandler][Exception]")
+    {
+        RebuildHandler handler;
+        REQUIRE_THROWS_AS(json.parseBuffer("{\"a\" : [1, 2, }", handler), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBuffer("", handler), std::invalid_argument);
+    }
+}
+TEST_CASE("Creation and use of JSONReader to pull tokens from JSON.", "[JSON][Parse][JSONReader]")
+{
+    SECTION("Read each example JSON file and check JSON rebuilt from tokens is the same as stringified JNodes", "[JSON][Parse][JSONReader]")
+    {
+        JSON json;
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            std::string jsonFileBuffer = readJSONFromFile(testFile);
+            JSONReader reader(jsonFileBuffer);
+            RebuildHandler handler;
+            for (JSONReader::Token token = reader.next(); token != JSONReader::Token::end; token = reader.next())
+            {
+                switch (token)
+                {
+                case JSONReader::Token::objectStart:
+                    handler.onObjectStart();
+                    break;
+                case JSONReader::Token::objectEnd:
+                    handler.onObjectEnd();
+                    break;
+                case JSONReader::Token::arrayStart:
+                    handler.onArrayStart();
+                    break;
+                case JSONReader::Token::arrayEnd:
+                    handler.onArrayEnd();
+                    break;
+                case JSONReader::Token::key:
+                    handler.onKey(reader.getString());
+                    break;
+                case JSONReader::Token::string:
+                    handler.onString(reader.getString());
+                    break;
+                case JSONReader::Token::number:
+                    handler.onNumber(reader.getNumeric(), reader.getNumber());
+                    break;
+                case JSONReader::Token::boolean:
+                    handler.onBoolean(reader.getBoolean());
+                    break;
+                case JSONReader::Token::null:
+                    handler.onNull();
+                    break;
+                default:
+                    break;
+                }
+            }
+            REQUIRE(handler.m_json == json.stringifyToBuffer(json.parseBuffer(jsonFileBuffer)));
+        }
+    }
+    SECTION("Read tokens from an ISource and check values and depths", "[JSON][Parse][JSONReader]")
+    {
+        BufferSource source("{\"a\" : [1, \"two\", true, null, {\"c\" : 3}], \"b\" : -2.5 }");
+        JSONReader reader(source);
+        REQUIRE(reader.next() == JSONReader::Token::objectStart);
+        REQUIRE(reader.getDepth() == 1);
+        REQUIRE(reader.next() == JSONReader::Token::key);
+        REQUIRE(reader.getString() == "a");
+        REQUIRE(reader.next() == JSONReader::Token::arrayStart);
+        REQUIRE(reader.getDepth() == 2);
+        REQUIRE(reader.next() == JSONReader::Token::number);
+        REQUIRE(reader.getNumber() == "1");
+        REQUIRE(reader.getNumeric().integer == 1);
+        REQUIRE(reader.next() == JSONReader::Token::string);
+        REQUIRE(reader.getString() == "two");
+        REQUIRE(reader.next() == JSONReader::Token::boolean);
+        REQUIRE(reader.getBoolean());
+        REQUIRE(reader.next() == JSONReader::Token::null);
+        REQUIRE(reader.next() == JSONReader::Token::objectStart);
+        REQUIRE(reader.getDepth() == 3);
+        REQUIRE(reader.next() == JSONReader::Token::key);
+        REQUIRE(reader.getString() == "c");
+        REQUIRE(reader.next() == JSONReader::Token::number);
+        REQUIRE(reader.next() == JSONReader::Token::objectEnd);
+        REQUIRE(reader.next() == JSONReader::Token::arrayEnd);
+        REQUIRE(reader.getDepth() == 1);
+        REQUIRE(reader.next() == JSONReader::Token::key);
+        REQUIRE(reader.getString() == "b");
+        REQUIRE(reader.next() == JSONReader::Token::number);
+        REQUIRE(reader.getNumeric().floatingPoint == -2.5);
+        REQUIRE(reader.next() == JSONReader::Token::objectEnd);
+        REQUIRE(reader.getDepth() == 0);
+        REQUIRE(reader.next() == JSONReader::Token::end);
+        REQUIRE(reader.next() == JSONReader::Token::end);
+    }
+    SECTION("Skip values and check the next token read is the one after them", "[JSON][Parse][JSONReader]")
+    {
+        JSONReader reader("{\"skip\" : {\"x\" : [1, \"]}\\\"\", {\"y\" : []}]}, \"keep\" : [[1], 2]}");
+        REQUIRE(reader.next() == JSONReader::Token::objectStart);
+        REQUIRE(reader.next() == JSONReader::Token::key);
+        reader.skipValue();
+        REQUIRE(reader.getToken() == JSONReader::Token::objectEnd);
+        REQUIRE(reader.next() == JSONReader::Token::key);
+        REQUIRE(reader.getString() == "keep");
+        REQUIRE(reader.next() == JSONReader::Token::arrayStart);
+        REQUIRE(reader.next() == JSONReader::Token::arrayStart);
+        reader.skipValue();
+        REQUIRE(reader.getToken() == JSONReader::Token::arrayEnd);
+        REQUIRE(reader.next() == JSONReader::Token::number);
+        REQUIRE(reader.getNumber() == "2");
+        reader.skipValue();
+        REQUIRE(reader.next() == JSONReader::Token::arrayEnd);
+        REQUIRE(reader.next() == JSONReader::Token::objectEnd);
+        REQUIRE(reader.next() == JSONReader::Token::end);
+    }
+    SECTION("Read tokens with syntax errors", "[JSON][Parse][JSONReader][Exception]")
+    {
+        auto readAll = [](std::string_view jsonBuffer)
+        {
+            JSONReader reader(jsonBuffer);
+            while (reader.next() != JSONReader::Token::end)
+            {
+            }
+        };
+        REQUIRE_THROWS_AS(readAll("{\"a\" : [1, 2, }"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(readAll("{\"a\" 1}"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(readAll("[1, 2"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(readAll(""), std::invalid_argument);
+        JSONReader reader("[[1, 2]");
+        reader.next();
+        REQUIRE_THROWS_AS(reader.skipValue(), JSON::SyntaxError);
+    }
+    SECTION("Read JSON that parseBuffer rejects and check the reader rejects it too", "[JSON][Parse][JSONReader][Exception]")
+    {
+        JSON json;
+        auto readAll = [](std::string_view jsonBuffer, std::size_t maxNestingDepth)
+        {
+            JSONReader reader(jsonBuffer);
+            reader.maxNestingDepth(maxNestingDepth);
+            while (reader.next() != JSONReader::Token::end)
+            {
+            }
+        };
+        for (auto jsonBuffer : {"{}", "[]", "{\"a\" : { }}", "[1, [ ]]"})
+        {
+            REQUIRE_THROWS_AS(json.parseBuffer(jsonBuffer), JSON::SyntaxError);
+            REQUIRE_THROWS_AS(readAll(jsonBuffer, JSON::kDefaultMaxNestingDepth), JSON::SyntaxError);
+        }
+        REQUIRE_NOTHROW(readAll("[[[1]], {\"a\" : [2]}]", 3));
+        REQUIRE_THROWS_WITH(readAll("[[[[1]]]]", 3), "Maximum nesting depth exceeded.");
+        REQUIRE_THROWS_AS(readAll(std::string(JSON::kDefaultMaxNestingDepth + 1, '['), JSON::kDefaultMaxNestingDepth), JSON::SyntaxError);
+    }
+    SECTION("Interleave two readers and a parse and check each reader's strings are not overwritten", "[JSON][Parse][JSONReader]")
+    {
+        JSON json;
+        JSONReader a("\"a\\nA\""), b("\"b\\nB\"");
+        a.next();
+        std::string_view string = a.getString();
+        b.next();
+        REQUIRE(string == "a\nA");
+        REQUIRE(b.getString() == "b\nB");
+        JSONReader keys("{\"k\\u0031\" : \"v\\u0031\"}");
+        keys.next();
+        keys.next();
+        std::string_view key = keys.getString();
+        json.parseBuffer("[\"x\\ty\"]");
+        REQUIRE(key == "k1");
+        REQUIRE(string == "a\nA");
+    }
+}
+TEST_CASE("Creation and use of JSONPushParser to parse JSON fed in chunks.", "[JSON][Parse][JSONPushParser]")
+{
+    JSON json;
+    SECTION("Feed each example JSON file in chunks of various sizes and check JNodes built are the same as parsed", "[JSON][Parse][JSONPushParser]")
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            std::string jsonFileBuffer = readJSONFromFile(testFile);
+            std::string expected = json.stringifyToBuffer(json.parseBuffer(jsonFileBuffer));
+            for (std::size_t chunkSize : {1, 2, 7, 64, 100000})
+            {
+                JSONPushParser pushParser;
+                for (std::size_t chunk = 0; chunk < jsonFileBuffer.size(); chunk += chunkSize)
+                {
+                    pushParser.feed(std::string_view(jsonFileBuffer).substr(chunk, chunkSize));
+                }
+                REQUIRE(pushParser.isComplete());
+                pushParser.finish();
+                REQUIRE(json.stringifyToBuffer(pushParser.getRoot()) == expected);
+            }
+        }
+    }
+    SECTION("Feed JSON a byte at a time and check events raised on a handler", "[JSON][Parse][JSONPushParser]")
+    {
+        std::string jsonBuffer = readJSONFromFile("./testData/testfile002.json");
+        RebuildHandler handler;
+        JSONPushParser pushParser(handler);
+        for (char byte : jsonBuffer)
+        {
+            pushParser.feed(std::string_view(&byte, 1));
+        }
+        pushParser.finish();
+        REQUIRE(handler.m_json == json.stringifyToBuffer(json.parseBuffer(jsonBuffer)));
+        REQUIRE_THROWS_AS(pushParser.getRoot(), std::runtime_error);
+    }
+    SECTION("Feed strings split within escapes, numbers and literals", "[JSON][Parse][JSONPushParser]")
+    {
+        JSONPushParser pushParser;
+        for (auto chunk : {"{\"a\\", "\"b\" : [\"\\u00", "41\\", "\"\", 12", "3.4", "e2, tr", "ue, n", "ull, {\"c\" : 1}, [2]]}"})
+        {
+            pushParser.feed(chunk);
+        }
+        REQUIRE(pushParser.isComplete());
+        REQUIRE(json.stringifyToBuffer(pushParser.getRoot()) == "{\"a\\\"b\":[\"A\\\"\",12340,true,null,{\"c\":1},[2]]}");
+        JSONPushParser numberParser;
+        numberParser.feed("  -12");
+        numberParser.feed("5.5 ");
+        REQUIRE(numberParser.isComplete());
+        JSONPushParser trueParser;
+        trueParser.feed("tr");
+        trueParser.feed("ue");
+        REQUIRE_FALSE(trueParser.isComplete());
+        trueParser.finish();
+        REQUIRE(JNodeRef<JNodeBoolean>(*trueParser.getRoot()).getBoolean());
+    }
+    SECTION("Feed JSON with syntax errors", "[JSON][Parse][JSONPushParser][Exception]")
+    {
+        auto feedAll = [](std::string_view jsonBuffer)
+        {
+            JSONPushParser pushParser;
+            pushParser.feed(jsonBuffer);
+            pushParser.finish();
+        };
+        REQUIRE_THROWS_AS(feedAll("{\"a\" : [1, 2, }"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("{\"a\" 1}"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("[1, 2]]"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("[1, 2}"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("[01]"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("[tru]"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("{\"a\" : \"b"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(feedAll("[1, 2"), JSON::SyntaxError);
+        JSONPushParser pushParser;
+        pushParser.feed("[1, 2");
+        REQUIRE_THROWS_AS(pushParser.getRoot(), std::runtime_error);
+    }
+    SECTION("Feed JSON that parseBuffer rejects and check the push parser rejects it too", "[JSON][Parse][JSONPushParser][Exception]")
+    {
+        auto feedAll = [](std::string_view jsonBuffer, std::size_t maxNestingDepth)
+        {
+            JSONPushParser pushParser;
+            pushParser.maxNestingDepth(maxNestingDepth);
+            pushParser.feed(jsonBuffer);
+            pushParser.finish();
+        };
+        for (auto jsonBuffer : {"{}", "[]", "{\"a\" : { }}", "[1, [ ]]"})
+        {
+            REQUIRE_THROWS_AS(json.parseBuffer(jsonBuffer), JSON::SyntaxError);
+            REQUIRE_THROWS_AS(feedAll(jsonBuffer, JSON::kDefaultMaxNestingDepth), JSON::SyntaxError);
+        }
+        REQUIRE_NOTHROW(feedAll("[[[1]], {\"a\" : [2]}]", 3));
+        REQUIRE_THROWS_WITH(feedAll("[[[[1]]]]", 3), "Maximum nesting depth exceeded.");
+        REQUIRE_THROWS_AS(feedAll(std::string(JSON::kDefaultMaxNestingDepth + 1, '['), JSON::kDefaultMaxNestingDepth), JSON::SyntaxError);
+    }
+}
+TEST_CASE("Creation and use of NDJSONReader to parse records in parallel.", "[JSON][Parse][NDJSONReader]")
+{
+    JSON json;
+    std::vector<std::string> expected;
+    std::string ndjsonBuffer;
+    for (int record = 0; record < 100; record++)
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            expected.push_back(json.stringifyToBuffer(json.parseFile(testFile)));
+            ndjsonBuffer += expected.back() + ((record % 2) ? "\r\n" : "\n");
+        }
+    }
+    SECTION("Parse records in order and check each is the same as the line it came from", "[JSON][Parse][NDJSONReader]")
+    {
+        NDJSONReader ndjsonReader(4, true, 1024);
+        std::vector<std::string> records;
+        std::size_t lastOffset = 0;
+        REQUIRE(ndjsonReader.parseBuffer(ndjsonBuffer, [&](NDJSONReader::Record &record)
+                                         {
+                                             REQUIRE(record.error.empty());
+                                             REQUIRE((records.empty() || (record.offset > lastOffset)));
+                                             lastOffset = record.offset;
+                                             records.push_back(json.stringifyToBuffer(std::move(record.jNode))); }) == expected.size());
+        REQUIRE(records == expected);
+    }
+    SECTION("Parse records unordered and check all are delivered", "[JSON][Parse][NDJSONReader]")
+    {
+        NDJSONReader ndjsonReader(4, false, 1024);
+        std::vector<std::string> records;
+        ndjsonReader.parseBuffer(ndjsonBuffer, [&](NDJSONReader::Record &record)
+                                 { records.push_back(json.stringifyToBuffer(std::move(record.jNode))); });
+        std::sort(records.begin(), records.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(records == expected);
+    }
+    SECTION("Parse records from a file", "[JSON][Parse][NDJSONReader]")
+    {
+        std::filesystem::remove(kGeneratedJSONFile);
+        std::ofstream generated(kGeneratedJSONFile, std::ios_base::binary);
+        generated << ndjsonBuffer;
+        generated.close();
+        NDJSONReader ndjsonReader;
+        std::size_t records = 0;
+        REQUIRE(ndjsonReader.parseFile(kGeneratedJSONFile, [&](NDJSONReader::Record &record)
+                                       { REQUIRE(json.stringifyToBuffer(std::move(record.jNode)) == expected[records++]); }) == expected.size());
+    }
+    SECTION("Parse records with errors and check the rest of the batch is still parsed", "[JSON][Parse][NDJSONReader][Exception]")
+    {
+        NDJSONReader ndjsonReader(2, true, 16);
+        std::vector<std::size_t> errorOffsets;
+        std::size_t parsed = 0;
+        REQUIRE(ndjsonReader.parseBuffer("{\"a\" : 1}\n[1, 2,]\n\n  \n\"ok\"\n{\"b\" \n456", [&](NDJSONReader::Record &record)
+                                         {
+                                             if (record.jNode == nullptr)
+                                             {
+                                                 REQUIRE_FALSE(record.error.empty());
+                                                 errorOffsets.push_back(record.offset);
+                                             }
+                                             else
+                                             {
+                                                 parsed++;
+                                             } }) == 5);
+        REQUIRE(parsed == 3);
+        REQUIRE(errorOffsets == std::vector<std::size_t>{10, 27});
+    }
+    SECTION("Parse records followed by more than whitespace on their line and check each is reported as an error", "[JSON][Parse][NDJSONReader][Exception]")
+    {
+        NDJSONReader ndjsonReader(2, true, 16);
+        std::vector<std::size_t> errorOffsets;
+        std::vector<std::string> parsed;
+        REQUIRE(ndjsonReader.parseBuffer("{\"a\":1}{\"b\":2}\n[1] garbage\n[2]  \r\n", [&](NDJSONReader::Record &record)
+                                         {
+                                             if (record.jNode == nullptr)
+                                             {
+                                                 REQUIRE(record.error == "JSON syntax error detected.");
+                                                 errorOffsets.push_back(record.offset);
+                                             }
+                                             else
+                                             {
+                                                 parsed.push_back(JSON().stringifyToBuffer(*record.jNode));
+                                             } }) == 3);
+        REQUIRE(errorOffsets == std::vector<std::size_t>{0, 15});
+        REQUIRE(parsed == std::vector<std::string>{"[2]"});
+    }
+    SECTION("Parse records with the settings of a JSON object and check they are used", "[JSON][Parse][NDJSONReader]")
+    {
+        JSON settings;
+        settings.maxNestingDepth(2);
+        settings.keepNumberText(true);
+        NDJSONReader ndjsonReader(settings, 2, true, 16);
+        std::vector<std::string> results;
+        REQUIRE(ndjsonReader.parseBuffer("[1.50, [2]]\n[[[3]]]\n", [&](NDJSONReader::Record &record)
+                                         { results.push_back((record.jNode != nullptr) ? JSON().stringifyToBuffer(*record.jNode) : record.error); }) == 2);
+        REQUIRE(results == std::vector<std::string>{"[1.50,[2]]", "Maximum nesting depth exceeded."});
+    }
+    SECTION("Parse records with a callback that throws and check the exception is passed on", "[JSON][Parse][NDJSONReader][Exception]")
+    {
+        NDJSONReader ndjsonReader(4, true, 1024);
+        REQUIRE_THROWS_AS(ndjsonReader.parseBuffer(ndjsonBuffer, [](NDJSONReader::Record &)
+                                                   { throw std::runtime_error("Stop."); }),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(ndjsonReader.parseBuffer("", [](NDJSONReader::Record &) {}), std::invalid_argument);
+    }
+}
+TEST_CASE("Creation and use of JSON object for lazy parse.", "[JSON][Parse][Lazy]")
+{
+    JSON json;
+    SECTION("Lazy parse each example JSON file and check stringified JNodes are the same as for a full parse", "[JSON][Parse][Lazy]")
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            std::string jsonFileBuffer = readJSONFromFile(testFile);
+            REQUIRE(json.stringifyToBuffer(json.parseBufferLazy(jsonFileBuffer)) == json.stringifyToBuffer(json.parseBuffer(jsonFileBuffer)));
+            REQUIRE(json.stringifyToBuffer(json.parseFileLazy(testFile)) == json.stringifyToBuffer(json.parseFile(testFile)));
+        }
+    }
+    SECTION("Lazy parse and access fields through the index operators", "[JSON][Parse][Lazy]")
+    {
+        std::unique_ptr<JNode> jNode = json.parseBufferLazy(" {\"a\" : [1, {\"b\" : \"x\\ty \\\"]}\"}], \"c\" : \"\\u0041\", \"d\" : true}");
+        REQUIRE(jNode->nodeType == JNodeType::object);
+        REQUIRE(JNodeRef<JNodeObject>(*jNode).size() == 3);
+        REQUIRE(JNodeRef<JNodeString>((*jNode)["c"]).getString() == "A");
+        REQUIRE(JNodeRef<JNodeString>((*jNode)["a"][1]["b"]).getString() == "x\ty \"]}");
+        REQUIRE(JNodeRef<JNodeNumber>((*jNode)["a"][0]).getNumber() == "1");
+        REQUIRE(JNodeRef<JNodeBoolean>((*jNode)["d"]).getBoolean());
+        REQUIRE(JNodeRef<JNodeNumber>(*json.parseBufferLazy("  -45.5")).getNumber() == "-45.5");
+    }
+    SECTION("Lazy parse with syntax errors that are only found when a value is accessed", "[JSON][Parse][Lazy][Exception]")
+    {
+        std::unique_ptr<JNode> jNode;
+        REQUIRE_NOTHROW(jNode = json.parseBufferLazy("{\"ok\" : 1, \"bad\" : [1, 2,, 3]}"));
+        REQUIRE_NOTHROW((*jNode)["ok"]);
+        REQUIRE_THROWS_AS((*jNode)["bad"][0], JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferLazy("{\"a\" : [1, 2}"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferLazy("[\"a\", \"b]"), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferLazy(""), std::invalid_argument);
+    }
+    SECTION("Lazy parse with syntax errors and check they are reported on every access", "[JSON][Parse][Lazy][Exception]")
+    {
+        std::unique_ptr<JNode> jNode = json.parseBufferLazy("{\"a\":{\"x\":1,\"y\":tru},\"b\":[1,2,,3],\"c\":\"\\uzzzz\"}");
+        REQUIRE_THROWS_AS(JNodeRef<JNodeObject>((*jNode)["a"]).size(), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(JNodeRef<JNodeObject>((*jNode)["a"]).size(), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(JNodeRef<JNodeArray>((*jNode)["b"]).size(), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(JNodeRef<JNodeArray>((*jNode)["b"]).size(), JSON::SyntaxError);
+        REQUIRE_THROWS(JNodeRef<JNodeString>((*jNode)["c"]).getString());
+        REQUIRE_THROWS(JNodeRef<JNodeString>((*jNode)["c"]).getString());
+        REQUIRE_THROWS_AS(json.stringifyToBuffer(*jNode), JSON::SyntaxError);
+    }
+}
+TEST_CASE("Creation and use of JSON object to extract values addressed by JSON Pointers.", "[JSON][Parse][Extract]")
+{
+    JSON json;
+    std::string jsonBuffer{"{\"a\" : {\"b\" : [0, 1, 2, {\"c\" : \"found\"}], \"skip\" : {\"x\" : \"]}\\\"\"}}, \"m~n\" : 8, \"e/f\" : [true, null], \"\" : 0}"};
+    SECTION("Extract single values from an ISource", "[JSON][Parse][Extract]")
+    {
+        BufferSource source(jsonBuffer);
+        REQUIRE(JNodeRef<JNodeString>(*json.extract(source, "/a/b/3/c")).getString() == "found");
+        BufferSource sourceArray(jsonBuffer);
+        REQUIRE(json.stringifyToBuffer(json.extract(sourceArray, "/a/b")) == "[0,1,2,{\"c\":\"found\"}]");
+        BufferSource sourceWhole(jsonBuffer);
+        REQUIRE(json.stringifyToBuffer(json.extract(sourceWhole, "")) == json.stringifyToBuffer(json.parseBuffer(jsonBuffer)));
+    }
+    SECTION("Extract a batch of values (including escaped and missing ones) from a buffer", "[JSON][Parse][Extract]")
+    {
+        std::vector<std::unique_ptr<JNode>> results = json.extractFromBuffer(jsonBuffer, {"/m~0n", "/e~1f/1", "/a/b/2", "/a/b/02", "/a/b/-", "/a/missing", "/m~0n/deeper", "/", "/a/skip/x"});
+        REQUIRE(results.size() == 9);
+        REQUIRE(JNodeRef<JNodeNumber>(*results[0]).getNumber() == "8");
+        REQUIRE(results[1]->nodeType == JNodeType::null);
+        REQUIRE(JNodeRef<JNodeNumber>(*results[2]).getNumber() == "2");
+        REQUIRE(results[3] == nullptr);
+        REQUIRE(results[4] == nullptr);
+        REQUIRE(results[5] == nullptr);
+        REQUIRE(results[6] == nullptr);
+        REQUIRE(JNodeRef<JNodeNumber>(*results[7]).getNumber() == "0");
+        REQUIRE(JNodeRef<JNodeString>(*results[8]).getString() == "]}\"");
+    }
+    SECTION("Extract values where one pointer addresses a value inside that of another", "[JSON][Parse][Extract]")
+    {
+        std::vector<std::unique_ptr<JNode>> results = json.extractFromBuffer(jsonBuffer, {"/a", "/a/b/3/c", "/a"});
+        REQUIRE(json.stringifyToBuffer(std::move(results[0])) == "{\"b\":[0,1,2,{\"c\":\"found\"}],\"skip\":{\"x\":\"]}\\\"\"}}");
+        REQUIRE(JNodeRef<JNodeString>(*results[1]).getString() == "found");
+        REQUIRE(results[2]->nodeType == JNodeType::object);
+    }
+    SECTION("Extract stops once all values are found in an array so trailing errors are not seen", "[JSON][Parse][Extract]")
+    {
+        REQUIRE(JNodeRef<JNodeNumber>(*json.extractFromBuffer("[{\"id\" : 1}, [1, 2,, }", {"/0/id"})[0]).getNumber() == "1");
+        REQUIRE_THROWS_AS(json.extractFromBuffer("[{\"id\" : 1}, [1, 2,, }", {"/0/missing"}), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.extractFromBuffer("{\"id\" : 1, \"rest\" : [1, 2,, }", {"/id"}), JSON::SyntaxError);
+    }
+    SECTION("Extract from an object with duplicate keys and check the last is used as by parseBuffer", "[JSON][Parse][Extract]")
+    {
+        std::string duplicates{"{\"a\" : {\"b\" : 1, \"c\" : [1, 2]}, \"x\" : 2, \"a\" : {\"c\" : [3, {\"d\" : null}]}}"};
+        std::vector<std::unique_ptr<JNode>> results = json.extractFromBuffer(duplicates, {"/a/b", "/a/c/0", "/a", "/a/c/1/d", "/x"});
+        REQUIRE(results[0] == nullptr);
+        REQUIRE(JNodeRef<JNodeNumber>(*results[1]).getNumber() == "3");
+        REQUIRE(json.stringifyToBuffer(*results[2]) == json.stringifyToBuffer((*json.parseBuffer(duplicates))["a"]));
+        REQUIRE(results[3]->nodeType == JNodeType::null);
+        REQUIRE(JNodeRef<JNodeNumber>(*results[4]).getNumber() == "2");
+    }
+    SECTION("Extract from each example JSON file and check whole document is the same as a full parse", "[JSON][Parse][Extract]")
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            REQUIRE(json.stringifyToBuffer(std::move(json.extractFromFile(testFile, {""})[0])) == json.stringifyToBuffer(json.parseFile(testFile)));
+            REQUIRE_NOTHROW(json.extractFromFile(testFile, {"/not/there"}));
+        }
+    }
+    SECTION("Extract with invalid JSON Pointers", "[JSON][Parse][Extract][Exception]")
+    {
+        REQUIRE_THROWS_AS(json.extractFromBuffer(jsonBuffer, {"a/b"}), std::invalid_argument);
+        REQUIRE_THROWS_AS(json.extractFromBuffer(jsonBuffer, {"/a~2"}), std::invalid_argument);
+        REQUIRE_THROWS_AS(json.extractFromBuffer("", {"/a"}), std::invalid_argument);
+    }
+    SECTION("Extract from JSON with syntax errors in the values skipped", "[JSON][Parse][Extract][Exception]")
+    {
+        for (auto malformed : {"{\"a\":},\"b\":1}", "{\"a\":[1 2],\"b\":1}", "{\"a\":{\"x\" 1},\"b\":1}", "{\"a\":{1:2},\"b\":1}",
+                               "{\"a\":[1,],\"b\":1}", "{\"a\":tru,\"b\":1}", "{\"a\":[}],\"b\":1}", "{\"a\":-,\"b\":1}"})
+        {
+            REQUIRE_THROWS_AS(json.extractFromBuffer(malformed, {"/b"}), JSON::SyntaxError);
+        }
+        REQUIRE(json.stringifyToBuffer(std::move(json.extractFromBuffer("{\"a\":[1,{\"x\":\"]\"}],\"b\":1}", {"/b"})[0])) == "1");
+        json.maxNestingDepth(2);
+        REQUIRE_THROWS_WITH(json.extractFromBuffer("{\"a\":[[[1]]],\"b\":1}", {"/b"}), "Maximum nesting depth exceeded.");
+    }
+}
+TEST_CASE("Creation and use of JSON object for parallel parse of a top level array.", "[JSON][Parse][Parallel]")
+{
+    JSON json;
+    std::string jsonBuffer{"["};
+    for (int record = 0; record < 100; record++)
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            jsonBuffer += readJSONFromFile(testFile) + " ,\n";
+        }
+    }
+    jsonBuffer += "\"last\", [1, [2, [3]]]  ]";
+    SECTION("Parse a large array on a number of threads and check it is the same as parsed by parseBuffer", "[JSON][Parse][Parallel]")
+    {
+        std::string expected = json.stringifyToBuffer(json.parseBuffer(jsonBuffer));
+        for (unsigned threadCount : {1, 2, 3, 8})
+        {
+            std::unique_ptr<JNode> jNode = json.parseBufferParallel(jsonBuffer, threadCount);
+            REQUIRE(JNodeRef<JNodeArray>(*jNode).size() == 502);
+            REQUIRE(json.stringifyToBuffer(std::move(jNode)) == expected);
+        }
+    }
+    SECTION("Parse a file and JSON that is not an array in parallel", "[JSON][Parse][Parallel]")
+    {
+        REQUIRE(json.stringifyToBuffer(json.parseFileParallel("./testData/testfile003.json")) == json.stringifyToBuffer(json.parseFile("./testData/testfile003.json")));
+        REQUIRE(JNodeRef<JNodeArray>(*json.parseBufferParallel("[1, 2, 3]", 4)).size() == 3);
+    }
+    SECTION("Parse in parallel with syntax errors", "[JSON][Parse][Parallel][Exception]")
+    {
+        REQUIRE_THROWS_AS(json.parseBufferParallel(jsonBuffer.substr(0, jsonBuffer.size() - 1), 4), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferParallel(jsonBuffer.substr(0, jsonBuffer.size() - 3) + ",]", 4), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferParallel(jsonBuffer.substr(0, jsonBuffer.size() - 1) + "}", 4), JSON::SyntaxError);
+        std::string badElement{jsonBuffer};
+        badElement[badElement.find(" ,\n", badElement.size() / 2) + 1] = ':';
+        REQUIRE_THROWS_AS(json.parseBufferParallel(badElement, 4), JSON::SyntaxError);
+    }
+}
+TEST_CASE("Creation and use of JSON object for parse and stringify of deeply nested JSON.", "[JSON][Parse][Nesting]")
+{
+    JSON json;
+    auto nestedJSON = [](std::size_t depth)
+    {
+        std::string jsonBuffer;
+        for (std::size_t level = 0; level < depth; level++)
+        {
+            jsonBuffer += (level & 1) ? "{\"a\":" : "[";
+        }
+        jsonBuffer += "1";
+        for (std::size_t level = depth; level-- > 0;)
+        {
+            jsonBuffer += (level & 1) ? "}" : "]";
+        }
+        return (jsonBuffer);
+    };
+    SECTION("Parse and stringify JSON nested to the default maximum depth", "[JSON][Parse][Nesting]")
+    {
+        std::string jsonBuffer = nestedJSON(JSON::kDefaultMaxNestingDepth);
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer(jsonBuffer)) == jsonBuffer);
+    }
+    SECTION("Parse and stringify JSON nested 200000 deep on a worker thread", "[JSON][Parse][Nesting]")
+    {
+        std::string jsonBuffer = nestedJSON(200000);
+        std::string stringified;
+        std::string stringifiedJValues;
+        std::size_t events = 0;
+        std::thread worker([&]()
+                           {
+                               struct CountHandler : JSON::IHandler
+                               {
+                                   void onObjectStart() override { count++; }
+                                   void onArrayStart() override { count++; }
+                                   std::size_t count = 0;
+                               } handler;
+                               json.maxNestingDepth(200000);
+                               stringified = json.stringifyToBuffer(json.parseBuffer(jsonBuffer));
+                               json.parseBuffer(jsonBuffer, handler);
+                               events = handler.count;
+                               stringifiedJValues = json.stringifyToBuffer(json.parseBufferToJValues(jsonBuffer)); });
+        worker.join();
+        REQUIRE(stringified == jsonBuffer);
+        REQUIRE(stringifiedJValues == jsonBuffer);
+        REQUIRE(events == 200000);
+    }
+    SECTION("Lazily parse JSON nested 100000 deep and walk down to the innermost value", "[JSON][Parse][Nesting][Lazy]")
+    {
+        json.maxNestingDepth(100000);
+        std::string jsonBuffer = nestedJSON(100000);
+        std::unique_ptr<JNode> jNode = json.parseBufferLazy(jsonBuffer);
+        JNode *level = jNode.get();
+        for (std::size_t depth = 0; depth < 100000; depth++)
+        {
+            level = (depth & 1) ? &(*level)["a"] : &(*level)[0];
+        }
+        REQUIRE(JNodeRef<JNodeNumber>(*level).getNumber() == "1");
+    }
+    SECTION("Lazily parse JSON nested deeper than the maximum depth", "[JSON][Parse][Nesting][Lazy][Exception]")
+    {
+        REQUIRE_THROWS_WITH(json.parseBufferLazy(nestedJSON(JSON::kDefaultMaxNestingDepth + 1)), "Maximum nesting depth exceeded.");
+        REQUIRE_THROWS_WITH(json.parseBufferLazy("[1, [2, " + nestedJSON(JSON::kDefaultMaxNestingDepth - 1) + "]]"), "Maximum nesting depth exceeded.");
+        json.maxNestingDepth(8);
+        REQUIRE_THROWS_WITH(json.parseBufferLazy(nestedJSON(9)), "Maximum nesting depth exceeded.");
+        std::string jsonBuffer = nestedJSON(8);
+        REQUIRE(json.stringifyToBuffer(json.parseBufferLazy(jsonBuffer)) == jsonBuffer);
+        REQUIRE(json.stringifyToBuffer(json.parseBufferLazy("[\"[[[[[[[[[\", {\"a\" : \"]]]\"}]")) == "[\"[[[[[[[[[\",{\"a\":\"]]]\"}]");
+    }
+    SECTION("Parse JSON nested 200000 deep into JValues with the default maximum depth", "[JSON][Parse][Nesting][Exception]")
+    {
+        REQUIRE_THROWS_WITH(json.parseBufferToJValues(std::string(200000, '[')), "Maximum nesting depth exceeded.");
+        REQUIRE_THROWS_WITH(json.parseBufferToJValues(nestedJSON(200000)), "Maximum nesting depth exceeded.");
+        std::string jsonBuffer = nestedJSON(JSON::kDefaultMaxNestingDepth);
+        REQUIRE(json.stringifyToBuffer(json.parseBufferToJValues(jsonBuffer)) == jsonBuffer);
+    }
+    SECTION("Parse JSON nested deeper than the maximum depth", "[JSON][Parse][Nesting][Exception]")
+    {
+        REQUIRE_THROWS_AS(json.parseBuffer(nestedJSON(JSON::kDefaultMaxNestingDepth + 1)), JSON::SyntaxError);
+        json.maxNestingDepth(8);
+        REQUIRE_THROWS_WITH(json.parseBuffer(nestedJSON(9)), "Maximum nesting depth exceeded.");
+        BufferSource source(nestedJSON(9));
+        JSON::IHandler handler;
+        REQUIRE_THROWS_WITH(json.parse(source, handler), "Maximum nesting depth exceeded.");
+        REQUIRE_THROWS_WITH(json.parseBufferToJValues(nestedJSON(9)), "Maximum nesting depth exceeded.");
+        REQUIRE(json.stringifyToBuffer(json.parseBufferToJValues(nestedJSON(8))) == nestedJSON(8));
+        REQUIRE_THROWS_WITH(json.parseBuffer(nestedJSON(8).substr(0, 12)), "JSON syntax error detected.");
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer(nestedJSON(8))) == nestedJSON(8));
+    }
+    SECTION("Parse deeply nested JSON with a syntax error at the bottom and check the JSON object can still be used", "[JSON][Parse][Nesting][Exception]")
+    {
+        std::string jsonBuffer = nestedJSON(5000);
+        jsonBuffer[jsonBuffer.find('1')] = 'x';
+        REQUIRE_THROWS_AS(json.parseBuffer(jsonBuffer), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBuffer(nestedJSON(5000).substr(0, 7500)), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.parseBufferToJValues(jsonBuffer), JSON::SyntaxError);
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer("{\"one\": [1, {\"two\": 2}]}")) == "{\"one\":[1,{\"two\":2}]}");
+        REQUIRE(json.stringifyToBuffer(json.parseBufferToJValues("{\"one\": [1, {\"two\": 2}]}")) == "{\"one\":[1,{\"two\":2}]}");
+    }
+}
+TEST_CASE("Creation and use of one JSON object by several threads at once.", "[JSON][Parse][Threads]")
+{
+    JSON json;
+    std::string jsonBuffer{"{\"escaped\": \"Tab\\t \\u00e9\\u20AC \\uD834\\uDD1E Quote\\\" End\", \"files\": ["};
+    for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+    {
+        jsonBuffer += readJSONFromFile(testFile) + ",";
+    }
+    jsonBuffer.back() = ']';
+    jsonBuffer += "}";
+    SECTION("Parse, stringify and extract from many threads sharing one JSON object and translator", "[JSON][Parse][Threads]")
+    {
+        std::string expected = json.stringifyToBuffer(json.parseBuffer(jsonBuffer));
+        std::string expectedEscaped = json.stringifyToBuffer(std::move(json.extractFromBuffer(jsonBuffer, {"/escaped"})[0]));
+        std::vector<std::thread> workers;
+        std::vector<int> mismatches(8, 0);
+        for (std::size_t worker = 0; worker < mismatches.size(); worker++)
+        {
+            workers.emplace_back([&, worker]()
+                                 {
+                                     for (int iteration = 0; iteration < 20; iteration++)
+                                     {
+                                         mismatches[worker] += json.stringifyToBuffer(json.parseBuffer(jsonBuffer)) != expected;
+                                         mismatches[worker] += json.stringifyToBuffer(json.parseBufferToDocument(jsonBuffer)) != expected;
+                                         mismatches[worker] += json.stringifyToBuffer(std::move(json.extractFromBuffer(jsonBuffer, {"/escaped"})[0])) != expectedEscaped;
+                                     } });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        REQUIRE(mismatches == std::vector<int>(8, 0));
+    }
+    SECTION("Parse and stringify from inside the handler of a parse on the same thread", "[JSON][Parse][Threads]")
+    {
+        struct NestedHandler : JSON::IHandler
+        {
+            explicit NestedHandler(JSON &json) : m_json(json) {}
+            void onKey(std::string_view key) override
+            {
+                m_keys += m_json.stringifyToBuffer(m_json.parseBuffer("[\"" + std::string(key) + "\", [[1]]]"));
+            }
+            JSON &m_json;
+            std::string m_keys;
+        };
+        NestedHandler handler(json);
+        json.parseBuffer("{\"a\" : {\"b\" : [{\"c\" : 1}]}}", handler);
+        REQUIRE(handler.m_keys == "[\"a\",[[1]]][\"b\",[[1]]][\"c\",[[1]]]");
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer(jsonBuffer)) == json.stringifyToBuffer(json.parseBuffer(jsonBuffer)));
+    }
+    SECTION("Freeze a lazily parsed structure and read it from many threads without locking", "[JSON][Parse][Threads][Freeze]")
+    {
+        std::unique_ptr<JNode> parsed = json.parseBuffer(jsonBuffer);
+        std::string expected = json.stringifyToBuffer(*parsed);
+        std::string expectedEscaped{JNodeRef<JNodeString>((*parsed)["escaped"]).getString()};
+        std::unique_ptr<JNode> jNodeRoot = json.parseBufferLazy(jsonBuffer);
+        REQUIRE_FALSE(jNodeRoot->isFrozen());
+        jNodeRoot->freeze();
+        REQUIRE(jNodeRoot->isFrozen());
+        REQUIRE((*jNodeRoot)["files"][0].isFrozen());
+        const JNode &frozen = *jNodeRoot;
+        std::vector<std::thread> workers;
+        std::vector<int> mismatches(8, 0);
+        for (std::size_t worker = 0; worker < mismatches.size(); worker++)
+        {
+            workers.emplace_back([&, worker]()
+                                 {
+                                     for (int iteration = 0; iteration < 20; iteration++)
+                                     {
+                                         mismatches[worker] += json.stringifyToBuffer(frozen) != expected;
+                                         mismatches[worker] += std::string_view(JNodeRef<JNodeString>(frozen["escaped"]).getString()) != expectedEscaped;
+                                         mismatches[worker] += JNodeRef<JNodeObject>(frozen).getEntry("missing") != nullptr;
+                                     } });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        REQUIRE(mismatches == std::vector<int>(8, 0));
+        REQUIRE(JNodeRef<JNodeObject>(frozen).size() == 2);
+    }
+    SECTION("Adding entries to a frozen structure throws", "[JSON][Parse][Freeze][Exceptions]")
+    {
+        std::unique_ptr<JNode> jNodeRoot = json.parseBuffer("{\"a\" : [1, 2], \"b\" : {\"c\" : 3}}");
+        jNodeRoot->freeze();
+        REQUIRE_THROWS_AS(JNodeRef<JNodeObject>(*jNodeRoot).addEntry("d", json.parseBuffer("4")), std::runtime_error);
+        REQUIRE_THROWS_WITH(JNodeRef<JNodeArray>((*jNodeRoot)["a"]).addEntry(json.parseBuffer("3")), "Frozen JNode cannot be modified.");
+        REQUIRE_THROWS_AS(JNodeRef<JNodeObject>((*jNodeRoot)["b"]).addEntry("e", json.parseBuffer("5")), std::runtime_error);
+        REQUIRE(json.stringifyToBuffer(*jNodeRoot) == "{\"a\":[1,2],\"b\":{\"c\":3}}");
+    }
+}
+TEST_CASE("Creation and use of JSON object for parse into an arena allocated JSONDocument.", "[JSON][Parse][JSONDocument]")
+{
+    JSON json;
+    SECTION("Parse an array [\"Dog\",1964,true,null] into a document and check its contents.", "[JSON][Parse][JSONDocument]")
+    {
+        JSONDocument document = json.parseBufferToDocument("[\"Dog\",1964,true,null]");
+        checkArray(&document.root());
+        REQUIRE(document.root()[0].arenaOwned);
+    }
+    SECTION("Parse object {\"City\":\"Southampton\",\"Population\":500000} into a document and check its contents.", "[JSON][Parse][JSONDocument]")
+    {
+        JSONDocument document = json.parseBufferToDocument("{\"City\":\"Southampton\",\"Population\":500000}");
+        checkObject(&document.root());
+    }
+    SECTION("Parse a list of example JSON files into documents and check they stringify the same as a heap parse.", "[JSON][Parse][JSONDocument]")
+    {
+        auto testFile = GENERATE(values<std::string>({"./testData/testfile001.json",
+                                                      "./testData/testfile002.json",
+                                                      "./testData/testfile003.json",
+                                                      "./testData/testfile004.json",
+                                                      "./testData/testfile005.json"}));
+        JSONDocument document = json.parseFileToDocument(testFile);
+        REQUIRE(json.stringifyToBuffer(document) == json.stringifyToBuffer(json.parseFile(testFile)));
+    }
+    SECTION("Move a document and check the tree moves with it.", "[JSON][Parse][JSONDocument]")
+    {
+        JSONDocument document = json.parseBufferToDocument("[\"Dog\",1964,true,null]");
+        JSONDocument moved = std::move(document);
+        checkArray(&moved.root());
+        REQUIRE_THROWS_AS(document.root(), std::runtime_error);
+        REQUIRE_THROWS_WITH(document.root(), "JSONDocument does not contain a JNode tree.");
+    }
+    SECTION("Add JNodes to a document and check only those from its arena are accepted.", "[JSON][Parse][JSONDocument]")
+    {
+        JSONDocument document = json.parseBufferToDocument("{\"City\":\"Southampton\",\"Sizes\":[1,2]}");
+        JNodeRef<JNodeObject>(document.root()).addEntry("Population", document.makeJNode<JNodeNumber>("500000"));
+        JNodeRef<JNodeArray>(document.root()["Sizes"]).addEntry(document.makeJNode<JNodeNull>());
+        REQUIRE(json.stringifyToBuffer(document) == "{\"City\":\"Southampton\",\"Sizes\":[1,2,null],\"Population\":500000}");
+        REQUIRE_THROWS_WITH(JNodeRef<JNodeObject>(document.root()).addEntry("Heap", std::make_unique<JNodeNull>()),
+                            "JNode added to a JSONDocument must be allocated from its arena.");
+        REQUIRE_THROWS_WITH(JNodeRef<JNodeArray>(document.root()["Sizes"]).addEntry(std::make_unique<JNodeNull>()),
+                            "JNode added to a JSONDocument must be allocated from its arena.");
+        REQUIRE(JNodeRef<JNodeArray>(document.root()["Sizes"]).size() == 3);
+    }
+    SECTION("Parse document with a syntax error part way through.", "[JSON][Parse][JSONDocument][Exception]")
+    {
+        REQUIRE_THROWS_AS(json.parseBufferToDocument("{ \"one\" : [1, 2, \"three\"], \"two\" : 18987u3 }"), JSON::SyntaxError);
+    }
+    SECTION("Parse document passing a empty string", "[JSON][Parse][JSONDocument][Exception]")
+    {
+        REQUIRE_THROWS_AS(json.parseBufferToDocument(""), std::invalid_argument);
+        REQUIRE_THROWS_WITH(json.parseBufferToDocument(""), "Empty string passed to be parsed.");
+    }
+}
+TEST_CASE("Creation and use of JSON object for parse of packed numeric arrays.", "[JSON][Parse][Packed]")
+{
+    JSON json;
+    json.packNumbers(true);
+    SECTION("Arrays are only packed if asked for", "[JSON][Parse][Packed]")
+    {
+        JSON unpackedJSON;
+        std::unique_ptr<JNode> jNode = unpackedJSON.parseBuffer("[1, 2.5, 3]");
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeNumber>(std::as_const(*jNode)[1]).getNumeric().floatingPoint == 2.5);
+        JSON copiedJSON(json);
+        REQUIRE(JNodeRef<JNodeArray>(*copiedJSON.parseBuffer("[1, 2.5, 3]")).isPacked());
+    }
+    SECTION("Arrays of integers or of floating point numbers are packed", "[JSON][Parse][Packed]")
+    {
+        std::unique_ptr<JNode> jNode = json.parseBuffer("[1, -2, 3, 9007199254740992]");
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).getPackedNumeric(3).kind == JNumeric::Kind::integer);
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).size() == 4);
+        REQUIRE(std::vector<double>(JNodeRef<JNodeArray>(*jNode).getPackedNumbers().begin(), JNodeRef<JNodeArray>(*jNode).getPackedNumbers().end()) == std::vector<double>{1, -2, 3, 9007199254740992.0});
+        REQUIRE(json.stringifyToBuffer(*jNode) == "[1,-2,3,9007199254740992]");
+        jNode = json.parseBuffer("[0.5, -1.25, 3e10]");
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).getPackedNumeric(0).kind == JNumeric::Kind::floatingPoint);
+        REQUIRE(json.stringifyToBuffer(*jNode) == "[0.5,-1.25,3e+10]");
+        jNode = json.parseBuffer("[1, 2.5, 3.0, -4]");
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(json.stringifyToBuffer(*jNode) == "[1,2.5,3,-4]");
+        long longValue = 0;
+        REQUIRE(JNodeRef<JNodeNumber>((*jNode)[0]).getInteger(longValue));
+        REQUIRE(longValue == 1);
+        REQUIRE_FALSE(JNodeRef<JNodeNumber>((*jNode)[2]).getInteger(longValue));
+        REQUIRE(JNodeRef<JNodeNumber>((*jNode)[3]).getInteger(longValue));
+        REQUIRE(longValue == -4);
+        jNode = json.parseBuffer("{\"series\" : [[1, 2], [3.5, 4.5]], \"name\" : \"x\"}");
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["series"][0]).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["series"][1]).isPacked());
+        REQUIRE_FALSE(JNodeRef<JNodeArray>((*jNode)["series"]).isPacked());
+    }
+    SECTION("Arrays that are not all packable numbers are not packed", "[JSON][Parse][Packed]")
+    {
+        for (auto jsonBuffer : {"[1, \"two\", 3]", "[1, 9007199254740993]", "[18446744073709551615]", "[1, [2]]", "[1e999, 1]"})
+        {
+            std::unique_ptr<JNode> jNode = json.parseBuffer(jsonBuffer);
+            REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+            REQUIRE_THROWS_WITH(JNodeRef<JNodeArray>(*jNode).getPackedNumbers(), "JNodeArray is not packed.");
+            REQUIRE(json.stringifyToBuffer(*jNode) == json.stripWhiteSpaceBuffer(jsonBuffer));
+        }
+        json.keepNumberText(true);
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*json.parseBuffer("[1, 2, 3]")).isPacked());
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer("[1.50, 2.0]")) == "[1.50,2.0]");
+    }
+    SECTION("Accessing the elements of a packed array unpacks it", "[JSON][Parse][Packed]")
+    {
+        std::unique_ptr<JNode> jNode = json.parseBuffer("[10, 20, 30]");
+        REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1]).getNumber() == "20");
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).size() == 3);
+        jNode = json.parseBuffer("[0.25, 0.5]");
+        JNodeRef<JNodeArray>(*jNode).addEntry(json.parseBuffer("true"));
+        REQUIRE(json.stringifyToBuffer(*jNode) == "[0.25,0.5,true]");
+        jNode = json.parseBuffer("[[1, 2], [3]]");
+        REQUIRE(JNodeRef<JNodeNumber>((*jNode)[1][0]).getNumber() == "3");
+        REQUIRE_FALSE(JNodeRef<JNodeArray>((*jNode)[1]).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)[0]).isPacked());
+        JSONDocument document = json.parseBufferToDocument("{\"a\" : [1.5, 2.5, 3.5]}");
+        REQUIRE(JNodeRef<JNodeArray>(document.root()["a"]).isPacked());
+        REQUIRE(JNodeRef<JNodeNumber>(document.root()["a"][2]).getNumber() == "3.5");
+        REQUIRE(json.stringifyToBuffer(document) == "{\"a\":[1.5,2.5,3.5]}");
+    }
+    SECTION("Reading a packed array through a const reference or once frozen leaves it packed", "[JSON][Parse][Packed]")
+    {
+        std::unique_ptr<JNode> jNode = json.parseBuffer("{\"a\" : [1, 2.5, -3], \"b\" : [[4, 5], \"six\"]}");
+        const JNode &constJNode = *jNode;
+        const JNodeArray &packed = JNodeRef<JNodeArray>(constJNode["a"]);
+        REQUIRE(packed.size() == 3);
+        REQUIRE(packed.packedSize() == 3);
+        REQUIRE(packed.getPackedNumeric(0).integer == 1);
+        REQUIRE(packed.getPackedNumeric(1).floatingPoint == 2.5);
+        REQUIRE(packed.getPackedNumeric(2).integer == -3);
+        REQUIRE_THROWS_WITH(constJNode["a"][0], "Packed JNodeArray elements must be read with getPackedNumeric().");
+        REQUIRE_THROWS_AS(packed.getArray(), std::runtime_error);
+        REQUIRE(packed.isPacked());
+        jNode->freeze();
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["a"]).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["b"][0]).isPacked());
+        REQUIRE_THROWS_AS((*jNode)["b"][0][1], std::runtime_error);
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["b"][0]).getPackedNumeric(1).integer == 5);
+        REQUIRE(json.stringifyToBuffer(*jNode) == "{\"a\":[1,2.5,-3],\"b\":[[4,5],\"six\"]}");
+        REQUIRE(json.stringifyToBuffer(JSONTape::freeze(*jNode)) == "{\"a\":[1,2.5,-3],\"b\":[[4,5],\"six\"]}");
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)["a"]).packedSize() == 3);
+    }
+    SECTION("Large packed arrays stringify the same as their unpacked JNodes", "[JSON][Parse][Packed]")
+    {
+        std::string jsonBuffer{"["};
+        for (int index = 0; index < 10000; index++)
+        {
+            jsonBuffer += ((index % 7) ? std::to_string(index * 0.123456789 - 600.0) : std::to_string(index)) + ",";
+        }
+        jsonBuffer.back() = ']';
+        std::unique_ptr<JNode> packed = json.parseBuffer(jsonBuffer);
+        std::unique_ptr<JNode> unpacked = json.parseBuffer(jsonBuffer);
+        JNodeRef<JNodeArray>(*unpacked).getArray();
+        REQUIRE(JNodeRef<JNodeArray>(*packed).isPacked());
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*unpacked).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>(*packed).getPackedNumbers().size() == 10000);
+        REQUIRE(json.stringifyToBuffer(*packed) == json.stringifyToBuffer(*unpacked));
+        REQUIRE(json.stringifyToBuffer(JSONTape::freeze(*packed)) == json.stringifyToBuffer(*unpacked));
+        REQUIRE(JNodeRef<JNodeArray>(*packed).isPacked());
+    }
+    SECTION("Arrays are packed by the parallel parse and push parser too but not when lazily parsed", "[JSON][Parse][Packed]")
+    {
+        std::string jsonBuffer{"["};
+        for (int index = 0; index < 20000; index++)
+        {
+            jsonBuffer += std::to_string(index * 0.5) + ",";
+        }
+        jsonBuffer.back() = ']';
+        std::string expected = json.stringifyToBuffer(json.parseBuffer(jsonBuffer));
+        std::unique_ptr<JNode> jNode = json.parseBufferParallel(jsonBuffer, 4);
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(json.stringifyToBuffer(*jNode) == expected);
+        jsonBuffer.back() = ',';
+        jsonBuffer += "\"end\"]";
+        jNode = json.parseBufferParallel(jsonBuffer, 4);
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(json.stringifyToBuffer(*jNode) == json.stringifyToBuffer(json.parseBuffer(jsonBuffer)));
+        // Elements that cannot be packed at the start and in the middle
+        std::size_t middle = jsonBuffer.find(',', jsonBuffer.size() / 2) + 1;
+        std::string mixedBuffer = "[\"start\"," + jsonBuffer.substr(1, middle - 1) + "1152921504606846976," + jsonBuffer.substr(middle);
+        jNode = json.parseBufferParallel(mixedBuffer, 4);
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).size() == 20003);
+        REQUIRE(json.stringifyToBuffer(*jNode) == json.stringifyToBuffer(json.parseBuffer(mixedBuffer)));
+        JSON textJSON;
+        textJSON.packNumbers(true);
+        textJSON.keepNumberText(true);
+        jNode = textJSON.parseBufferParallel(expected, 4);
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(textJSON.stringifyToBuffer(*jNode) == expected);
+        JSONPushParser pushParser;
+        pushParser.packNumbers(true);
+        pushParser.feed("[1, 2.5, [3, 4], [5, \"six\"]]");
+        jNode = pushParser.getRoot();
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+        REQUIRE(JNodeRef<JNodeArray>((*jNode)[2]).isPacked());
+        REQUIRE_FALSE(JNodeRef<JNodeArray>((*jNode)[3]).isPacked());
+        REQUIRE(json.stringifyToBuffer(*jNode) == "[1,2.5,[3,4],[5,\"six\"]]");
+        jNode = json.parseBufferLazy("[1, 2, 3]");
+        REQUIRE(JNodeRef<JNodeArray>(*jNode).size() == 3);
+        REQUIRE_FALSE(JNodeRef<JNodeArray>(*jNode).isPacked());
+    }
+}
+TEST_CASE("Creation and use of JSONTape frozen from parsed JNodes.", "[JSON][Parse][Tape]")
+{
+    JSON json;
+    SECTION("Freeze each example JSON file and check the stringified tape is the same as for its JNodes", "[JSON][Parse][Tape]")
+    {
+        for (auto testFile : {"./testData/testfile001.json", "./testData/testfile002.json", "./testData/testfile003.json", "./testData/testfile004.json", "./testData/testfile005.json"})
+        {
+            std::unique_ptr<JNode> jNodeRoot = json.parseFile(testFile);
+            REQUIRE(json.stringifyToBuffer(JSONTape::freeze(*jNodeRoot)) == json.stringifyToBuffer(*jNodeRoot));
+            REQUIRE(json.stringifyToBuffer(JSONTape::freeze(*json.parseFileLazy(testFile))) == json.stringifyToBuffer(*jNodeRoot));
+        }
+    }
+    SECTION("Navigate a tape with the same accessors as JNodes", "[JSON][Parse][Tape]")
+    {
+        JSONTape tape = JSONTape::freeze(*json.parseBuffer("{\"name\" : \"A \\u0042\", \"list\" : [1, -2.5, 18446744073709551615, true, null, {\"x\" : [[3]]}], \"flag\" : false}"));
+        JTapeValue root = tape.root();
+        REQUIRE(root.getNodeType() == JNodeType::object);
+        REQUIRE(root.size() == 3);
+        REQUIRE(root.getKeys() == std::vector<std::string_view>{"name", "list", "flag"});
+        REQUIRE(root.getKey(2) == "flag");
+        REQUIRE(root.containsKey("list"));
+        REQUIRE_FALSE(root.containsKey("missing"));
+        REQUIRE(root["name"].getString() == "A B");
+        REQUIRE_FALSE(root["flag"].getBoolean());
+        REQUIRE(root["list"].size() == 6);
+        long longValue = 0;
+        REQUIRE(root["list"][0].getInteger(longValue));
+        REQUIRE(longValue == 1);
+        double doubleValue = 0.0;
+        REQUIRE(root["list"][1].getFloatingPoint(doubleValue));
+        REQUIRE(doubleValue == -2.5);
+        REQUIRE(root["list"][2].getNumber() == "18446744073709551615");
+        REQUIRE(root["list"][3].getBoolean());
+        REQUIRE(root["list"][4].getNull() == nullptr);
+        REQUIRE(root["list"][5]["x"][0].size() == 1);
+        std::string keys;
+        for (auto member = root.begin(); member != root.end(); ++member)
+        {
+            keys += std::string(member.key()) + ":" + std::to_string((*member).getNodeType()) + ";";
+        }
+        REQUIRE(keys == "name:4;list:2;flag:5;");
+        int elements = 0;
+        for (JTapeValue element : root["list"])
+        {
+            elements += element.getNodeType() != JNodeType::base;
+        }
+        REQUIRE(elements == 6);
+        REQUIRE_THROWS_WITH(root["missing"], "Invalid key used to access object.");
+        REQUIRE_THROWS_WITH(root["list"][6], "Invalid index used to access array.");
+        REQUIRE_THROWS_WITH(root["name"].getBoolean(), "JTapeValue is not a boolean.");
+        REQUIRE_THROWS_WITH(JSONTape().root(), "JSONTape does not contain a frozen JNode tree.");
+    }
+    SECTION("Save a tape to a buffer, copy it byte for byte and load it back", "[JSON][Parse][Tape]")
+    {
+        std::string jsonBuffer = readJSONFromFile("./testData/testfile002.json");
+        std::string expected = json.stringifyToBuffer(json.parseBuffer(jsonBuffer));
+        std::string tapeBuffer = JSONTape::freeze(*json.parseBuffer(jsonBuffer)).toBuffer();
+        std::vector<char> copy(tapeBuffer.size());
+        std::memcpy(copy.data(), tapeBuffer.data(), tapeBuffer.size());
+        JSONTape tape = JSONTape::fromBuffer(std::string_view(copy.data(), copy.size()));
+        REQUIRE(json.stringifyToBuffer(tape) == expected);
+        REQUIRE(tape.toBuffer() == tapeBuffer);
+    }
+    SECTION("Loading a corrupt tape buffer throws", "[JSON][Parse][Tape][Exceptions]")
+    {
+        std::string tapeBuffer = JSONTape::freeze(*json.parseBuffer("{\"a\" : [1, \"two\"], \"b\" : null}")).toBuffer();
+        REQUIRE_THROWS_WITH(JSONTape::fromBuffer(tapeBuffer.substr(0, tapeBuffer.size() - 1)), "Invalid JSONTape.");
+        REQUIRE_THROWS_WITH(JSONTape::fromBuffer(tapeBuffer.substr(0, 8)), "Invalid JSONTape.");
+        std::string badMagic = tapeBuffer;
+        badMagic[0] = 'X';
+        REQUIRE_THROWS_WITH(JSONTape::fromBuffer(badMagic), "Invalid JSONTape.");
+        // Corrupt each byte of the entries in turn; any tape that still loads must stringify
+        for (std::size_t offset = 24; offset < tapeBuffer.size(); offset++)
+        {
+            std::string corrupt = tapeBuffer;
+            corrupt[offset] = (char)(corrupt[offset] + 0x41);
+            try
+            {
+                json.stringifyToBuffer(JSONTape::fromBuffer(corrupt));
+            }
+            catch (std::exception &)
+            {
+            }
+        }
+    }
+    SECTION("Freeze and stringify a deeply nested structure", "[JSON][Parse][Tape][Nesting]")
+    {
+        std::string jsonBuffer = std::string(100000, '[') + "1" + std::string(100000, ']');
+        json.maxNestingDepth(100000);
+        JSONTape tape = JSONTape::freeze(*json.parseBuffer(jsonBuffer));
+        REQUIRE(tape.entries().size() == 100001);
+        REQUIRE(json.stringifyToBuffer(tape) == jsonBuffer);
+    }
+}
+TEST_CASE("Creation and use of JSON object for columnar extraction from arrays of records.", "[JSON][Parse][Columns]")
+{
+    JSON json;
+    const std::vector<JSONColumn::Field> fields{{"id", JSONColumn::Type::integer}, {"price", JSONColumn::Type::floatingPoint}, {"name", JSONColumn::Type::string}};
+    auto sameColumns = [](const std::vector<JSONColumn> &columns, const std::vector<JSONColumn> &expected)
+    {
+        REQUIRE(columns.size() == expected.size());
+        for (std::size_t column = 0; column < columns.size(); column++)
+        {
+            REQUIRE(columns[column].rows() == expected[column].rows());
+            REQUIRE(columns[column].floatingPoints == expected[column].floatingPoints);
+            REQUIRE(columns[column].integers == expected[column].integers);
+            REQUIRE(columns[column].strings == expected[column].strings);
+            REQUIRE(columns[column].offsets == expected[column].offsets);
+            REQUIRE(columns[column].nullBitmap == expected[column].nullBitmap);
+        }
+    };
+    std::string recordsBuffer{"[{\"id\" : 1, \"price\" : 2.5, \"name\" : \"one\", \"extra\" : {\"id\" : 99}},"
+                              " {\"name\" : \"t\\u0077o\", \"id\" : 2.0, \"price\" : 3},"
+                              " {\"id\" : null, \"price\" : \"free\", \"name\" : [\"x\"]},"
+                              " 42,"
+                              " {\"id\" : 4.5, \"price\" : true, \"id\" : 7, \"name\" : \"\"}]"};
+    SECTION("Extract columns from a buffer and check values and nulls", "[JSON][Parse][Columns]")
+    {
+        std::vector<JSONColumn> columns = json.extractColumnsFromBuffer(recordsBuffer, fields);
+        REQUIRE(columns.size() == 3);
+        REQUIRE(columns[0].name == "id");
+        REQUIRE(columns[0].rows() == 5);
+        // Last of the duplicate "id" keys is used
+        REQUIRE(columns[0].integers == std::vector<std::int64_t>{1, 2, 0, 0, 7});
+        REQUIRE(columns[0].nullBitmap == std::vector<std::uint64_t>{0b01100});
+        REQUIRE(columns[1].floatingPoints == std::vector<double>{2.5, 3.0, 0.0, 0.0, 0.0});
+        REQUIRE(columns[1].nullBitmap == std::vector<std::uint64_t>{0b11100});
+        REQUIRE(columns[2].getString(0) == "one");
+        REQUIRE(columns[2].getString(1) == "two");
+        REQUIRE(columns[2].isNull(2));
+        REQUIRE(columns[2].getString(2).empty());
+        REQUIRE(columns[2].isNull(3));
+        REQUIRE_FALSE(columns[2].isNull(4));
+        REQUIRE(columns[2].getString(4).empty());
+        REQUIRE(columns[2].strings == "onetwo");
+        REQUIRE(columns[2].offsets == std::vector<std::size_t>{0, 3, 6, 6, 6, 6});
+    }
+    SECTION("Extract columns from parsed JNodes the same as from a buffer", "[JSON][Parse][Columns]")
+    {
+        sameColumns(json.extractColumns(*json.parseBuffer(recordsBuffer), fields), json.extractColumnsFromBuffer(recordsBuffer, fields));
+        sameColumns(json.extractColumns(*json.parseBufferLazy(recordsBuffer), fields), json.extractColumnsFromBuffer(recordsBuffer, fields));
+        JSON packedJSON;
+        packedJSON.packNumbers(true);
+        std::unique_ptr<JNode> packed = packedJSON.parseBuffer("[1, 2, 3]");
+        sameColumns(json.extractColumns(*packed, fields), json.extractColumnsFromBuffer("[1, 2, 3]", fields));
+        REQUIRE(JNodeRef<JNodeArray>(*packed).isPacked());
+    }
+    SECTION("Extract columns from many records using several threads", "[JSON][Parse][Columns][Parallel]")
+    {
+        std::string jsonBuffer{"["};
+        for (int record = 0; record < 20000; record++)
+        {
+            jsonBuffer += "{\"name\" : \"record " + std::to_string(record) + "\", \"tags\" : [1, 2, {\"id\" : 0}], ";
+            jsonBuffer += (record % 5) ? "\"id\" : " + std::to_string(record * 3) + ", " : "";
+            jsonBuffer += "\"price\" : " + std::to_string(record * 0.25) + "},";
+        }
+        jsonBuffer.back() = ']';
+        std::vector<JSONColumn> expected = json.extractColumnsFromBuffer(jsonBuffer, fields, 1);
+        REQUIRE(expected[0].rows() == 20000);
+        REQUIRE(expected[0].integers[20] == 0);
+        REQUIRE(expected[0].isNull(20));
+        REQUIRE(expected[0].integers[21] == 63);
+        REQUIRE(expected[2].getString(19999) == "record 19999");
+        sameColumns(json.extractColumnsFromBuffer(jsonBuffer, fields, 4), expected);
+        sameColumns(json.extractColumnsFromBuffer(jsonBuffer, fields, 0), expected);
+        sameColumns(json.extractColumns(*json.parseBuffer(jsonBuffer), fields, 4), expected);
+        sameColumns(json.extractColumns(*json.parseBufferLazy(jsonBuffer), fields, 4), expected);
+        std::filesystem::remove(kGeneratedJSONFile);
+        std::ofstream generated(kGeneratedJSONFile, std::ios_base::binary);
+        generated << jsonBuffer;
+        generated.close();
+        sameColumns(json.extractColumnsFromFile(kGeneratedJSONFile, fields, 3), expected);
+    }
+    SECTION("Extracting columns from invalid input throws", "[JSON][Parse][Columns][Exceptions]")
+    {
+        REQUIRE_THROWS_AS(json.extractColumnsFromBuffer("{\"id\" : 1}", fields), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.extractColumnsFromBuffer("[{\"id\" : 1}] x", fields), JSON::SyntaxError);
+        REQUIRE_THROWS_AS(json.extractColumnsFromBuffer("[{\"id\" : 1}, {\"id\" 2}]", fields), JSON::SyntaxError);
+        REQUIRE_THROWS_WITH(json.extractColumnsFromBuffer("", fields), "Empty string passed to be parsed.");
+        REQUIRE_THROWS_WITH(json.extractColumnsFromBuffer(recordsBuffer, {}), "No fields passed to be extracted.");
+        REQUIRE_THROWS_WITH(json.extractColumns(*json.parseBuffer("{\"id\" : 1}"), fields), "JNode passed to have columns extracted is not an array.");
+        std::string jsonBuffer{"["};
+        for (int record = 0; record < 20000; record++)
+        {
+            jsonBuffer += (record == 15000) ? "{\"id\" : 1,}," : "{\"id\" : 1},";
+        }
+        jsonBuffer.back() = ']';
+        REQUIRE_THROWS_AS(json.extractColumnsFromBuffer(jsonBuffer, fields, 4), JSON::SyntaxError);
+    }
 }
 TEST_CASE("Parse generated exceptions.", "[JSON][Parse][Exceptions]")
 {
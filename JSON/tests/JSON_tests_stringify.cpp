@@ -75,8 +75,14 @@ TEST_CASE("Creation and use of JSON object for stringification of collection typ
     SECTION("Stringify an array ([true,\"Out of time\",789043e13,true]) and check its value", "[JSON][Stringify]")
     {
         std::string expected = "[true,\"Out of time\",789043e13,true]";
+        json.keepNumberText(true);
         REQUIRE(json.stringifyToBuffer(json.parseBuffer(expected)) == expected);
     }
+    SECTION("Stringify an array ([true,\"Out of time\",789043e13,true]) without number text kept and check numbers are in shortest form", "[JSON][Stringify]")
+    {
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer("[true,\"Out of time\",789043e13,true]")) == "[true,\"Out of time\",7.89043e+18,true]");
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer("[678.8990,-0.5E2,18446744073709551615]")) == "[678.899,-50,18446744073709551615]");
+    }
 }
 TEST_CASE("Stringify to a file and check result", "[JSON][Stringify][Exceptions]")
 {
@@ -141,6 +147,52 @@ TEST_CASE("Creation and use of JSON object for stringification of a list of exam
         REQUIRE(readJSONFromFile(kGeneratedJSONFile) == json.stripWhiteSpaceBuffer(jsonFileBuffer));
     }
 }
+TEST_CASE("Creation and use of JSON object for stringification of a const JNode structure that is left intact.", "[JSON][Stringify][Const]")
+{
+    JSON json;
+    std::string expected = "{\"City\":\"London\",\"Population\":8000000,\"Boroughs\":[\"Camden\",\"Hackney\",{\"Inner\":true}],\"Mayor\":null}";
+    SECTION("Stringify the same JNode structure to a buffer, a file and a destination and check it is unchanged", "[JSON][Stringify][Const]")
+    {
+        std::unique_ptr<JNode> jNodeRoot = json.parseBuffer(expected);
+        const JNode &jNode = *jNodeRoot;
+        REQUIRE(json.stringifyToBuffer(jNode) == expected);
+        REQUIRE(json.stringifyToBuffer(jNode) == expected);
+        std::filesystem::remove(kGeneratedJSONFile);
+        json.stringifyToFile(jNode, kGeneratedJSONFile);
+        REQUIRE(readJSONFromFile(kGeneratedJSONFile) == expected);
+        BufferDestination destination;
+        json.stringify(jNode, destination);
+        REQUIRE(destination.getBuffer() == expected);
+        REQUIRE(json.stringifyToBuffer(std::move(jNodeRoot)) == expected);
+    }
+    SECTION("Read a JNode structure through const references", "[JSON][Stringify][Const]")
+    {
+        std::unique_ptr<JNode> jNodeRoot = json.parseBuffer(expected);
+        const JNode &jNode = *jNodeRoot;
+        REQUIRE(JNodeRef<JNodeObject>(jNode).size() == 4);
+        REQUIRE(JNodeRef<JNodeObject>(jNode).containsKey("Mayor"));
+        REQUIRE(JNodeRef<JNodeObject>(jNode).getKeys() == std::vector<std::string_view>{"City", "Population", "Boroughs", "Mayor"});
+        REQUIRE(JNodeRef<JNodeObject>(jNode).getEntry("Missing") == nullptr);
+        REQUIRE(JNodeRef<JNodeObject>(jNode).getEntries().size() == 4);
+        REQUIRE(JNodeRef<JNodeString>(jNode["City"]).getString() == "London");
+        REQUIRE(JNodeRef<JNodeNumber>(jNode["Population"]).getNumber() == "8000000");
+        REQUIRE(JNodeRef<JNodeArray>(jNode["Boroughs"]).size() == 3);
+        REQUIRE(JNodeRef<JNodeArray>(jNode["Boroughs"]).getArray().size() == 3);
+        REQUIRE(JNodeRef<JNodeString>(*JNodeRef<JNodeArray>(jNode["Boroughs"]).getEntry(1)).getString() == "Hackney");
+        REQUIRE(JNodeRef<JNodeBoolean>(jNode["Boroughs"][2]["Inner"]).getBoolean());
+        REQUIRE(JNodeRef<JNodeNull>(jNode["Mayor"]).getNull() == nullptr);
+        REQUIRE_THROWS_AS(jNode["Missing"], std::runtime_error);
+        REQUIRE_THROWS_AS(jNode["Boroughs"][3], std::runtime_error);
+    }
+    SECTION("Stringify a lazily parsed JNode structure through a const reference", "[JSON][Stringify][Const]")
+    {
+        std::string jsonBuffer = "{\"Escaped\":\"Caf\\u00E9\",\"Boroughs\":[\"Camden\",{\"Inner\":true}]}";
+        std::unique_ptr<JNode> jNodeRoot = json.parseBufferLazy(jsonBuffer);
+        const JNode &jNode = *jNodeRoot;
+        REQUIRE(JNodeRef<JNodeString>(jNode["Escaped"]).getString() == "Caf\u00E9");
+        REQUIRE(json.stringifyToBuffer(jNode) == jsonBuffer);
+    }
+}
 TEST_CASE("Creation and use of JSON object for stringification of strings with escape characters.", "[JSON][Stringify]")
 {
     JSON json;
@@ -188,4 +240,19 @@ TEST_CASE("Creation and use of JSON object for stringification of strings with e
     {
         REQUIRE(json.stringifyToBuffer(json.parseBuffer("\"Test String \\u0123 \\u0456 \"")) == "\"Test String \\u0123 \\u0456 \"");
     }
+    SECTION("Stringify JSON string with escapes '\\u0001 \\u001F' to buffer and check value", "[JSON][Stringify]")
+    {
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer("\"Test String \\u0001 \\u001F \"")) == "\"Test String \\u0001 \\u001F \"");
+    }
+    SECTION("Stringify long JSON string with escapes spread through it to buffer and check value", "[JSON][Stringify]")
+    {
+        std::string expected = "\"" + std::string(37, 'a') + "\\\"" + std::string(21, 'b') + "\\\\" + std::string(16, 'c') + "\\n\\u00E9" + std::string(40, 'd') + "\"";
+        REQUIRE(json.stringifyToBuffer(json.parseBuffer(expected)) == expected);
+    }
+    SECTION("Stringify JSON string with non-ASCII characters using a translator that writes raw UTF-8 and check value", "[JSON][Stringify]")
+    {
+        JSONTranslator translator(true);
+        JSON rawJSON(&translator);
+        REQUIRE(rawJSON.stringifyToBuffer(rawJSON.parseBuffer("\"Caf\\u00E9 \\uD834\\uDD1E \\t\"")) == "\"Caf\u00E9 \U0001D11E \\t\"");
+    }
 }
\ No newline at end of file